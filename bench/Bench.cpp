@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Algorithms.h"
+#include "Archadian.h"
+#include "MapReader.h"
+#include "SyntheticMap.h"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * Tempos de uma etapa, em segundos, um por execução.
+	 */
+	struct Stage {
+		const char* name;
+		std::vector<double> seconds;
+	};
+
+	/**
+	 * Percentil pelo posto mais próximo: o menor tempo que é maior ou igual a `percent`% dos tempos.
+	 */
+	double percentile(std::vector<double> seconds, double percent) {
+		std::sort(seconds.begin(), seconds.end());
+		std::size_t rank = static_cast<std::size_t>(percent / 100.0 * static_cast<double>(seconds.size()) + 0.999999);
+		return seconds[std::clamp<std::size_t>(rank, 1, seconds.size()) - 1];
+	}
+
+	template <typename Function>
+	void measure(Stage& stage, Function&& function) {
+		Clock::time_point start = Clock::now();
+		function();
+		stage.seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+	}
+
+	/**
+	 * Formata o resultado como `Main.cpp`, em memória, para medir a saída sem depender do terminal.
+	 */
+	void format(const Archadian& archadian, std::string& out) {
+		out.clear();
+		auto line = [&](std::string_view text) {
+			out.append(text);
+			out.push_back('\n');
+		};
+
+		line(archadian.getName(archadian.getCapital()));
+		Battalions battalions = archadian.hasBattalions() ? archadian.getBattalions() : Battalions();
+		line(std::to_string(battalions.size()));
+		for (CityId city : battalions)
+			line(archadian.getName(city));
+
+		line(std::to_string(archadian.getPatrolCount()));
+		for (std::size_t patrol = 0; patrol < archadian.getPatrolCount(); patrol++) {
+			for (CityId city : archadian.getPatrolling(patrol)) {
+				out.append(archadian.getName(city));
+				out.push_back(' ');
+			}
+			out.push_back('\n');
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	// Opções de geração do mapa (`SyntheticMap::usage`), mais:
+	// --runs R: número de execuções de cada etapa.
+	// -t N / --threads N: threads de `calcCapital` e das patrulhas (0 usa todos os processadores).
+	SyntheticMap::Options options;
+	std::size_t runs = 5;
+	std::size_t threads = 1;
+	bool valid = argc % 2 == 1;
+	for (int i = 1; valid && i + 1 < argc; i += 2) {
+		if (std::strcmp(argv[i], "--runs") == 0) runs = std::max<std::size_t>(1, std::stoul(argv[i + 1]));
+		else if (std::strcmp(argv[i], "-t") == 0 || std::strcmp(argv[i], "--threads") == 0) threads = std::stoul(argv[i + 1]);
+		else valid = SyntheticMap::parseOption(argv[i], argv[i + 1], options);
+	}
+	if (!valid || !SyntheticMap::isValid(options)) {
+		std::cerr << "Uso: " << argv[0] << " [opcoes]\n" << SyntheticMap::usage()
+			<< "  --runs R         execucoes de cada etapa (5)\n"
+			<< "  -t N             threads do calculo da capital e das patrulhas; 0 usa todos os processadores (1)\n";
+		return 1;
+	}
+
+	// O mapa é escrito uma única vez em um arquivo temporário, lido por `MapReader` como pelo programa.
+	SyntheticMap map = SyntheticMap::generate(options);
+	char path[] = "/tmp/archadian-bench-XXXXXX";
+	int file = mkstemp(path);
+	if (file < 0) {
+		std::cerr << "Nao foi possivel criar o mapa temporario" << std::endl;
+		return 1;
+	}
+	close(file);
+	{
+		std::ofstream out(path);
+		map.write(out);
+	}
+
+	const std::size_t roads = map.roads().size();
+	std::cout << "mapa: " << map.cityCount() << " cidades, " << roads << " estradas, semente " << options.seed
+		<< ", " << runs << " execucoes, " << threads << " thread(s)" << '\n';
+
+	std::vector<Stage> stages{ { "parse", {} }, { "graph", {} }, { "capital", {} },
+		{ "kosaraju", {} }, { "patrol", {} }, { "output", {} } };
+	std::size_t components = 0;
+	std::string output;
+
+	for (std::size_t run = 0; run < runs; run++) {
+		int fd = open(path, O_RDONLY);
+		MapReader reader(fd);
+		measure(stages[0], [&] { reader.parse(); });
+
+		Archadian archadian;
+		measure(stages[1], [&] {
+			NameTable names;
+			std::vector<City> nodes;
+			nodes.reserve(reader.names().size());
+			for (std::size_t i = 0; i < reader.names().size(); i++)
+				nodes.push_back(City(i + 1, names.add(reader.names()[i])));
+			Graph graph(nodes.size(), reader.edges());
+			archadian = Archadian(std::move(nodes), std::move(graph), std::move(names));
+			});
+		close(fd);
+
+		measure(stages[2], [&] { archadian.calcCapital(threads); });
+
+		measure(stages[3], [&] {
+			std::vector<CityId> order(archadian.getGraph().size());
+			for (CityId node = 0; node < order.size(); node++) order[node] = node;
+			components = Algorithms::Kosaraju(archadian.getGraph(), order).size();
+			});
+
+		measure(stages[4], [&] { archadian.calcBattalionsAndPatrolling(threads); });
+		measure(stages[5], [&] { format(archadian, output); });
+	}
+	std::remove(path);
+	std::cout << "componentes: " << components << ", saida: " << output.size() << " bytes" << '\n';
+
+	// Mediana, percentis e estradas por segundo pela mediana; as etapas só somam o que foi medido.
+	std::printf("%-10s %12s %12s %12s %12s %16s\n", "etapa", "mediana(ms)", "p90(ms)", "p99(ms)", "min(ms)", "estradas/s");
+	std::vector<double> total(runs, 0);
+	auto report = [&](const char* name, const std::vector<double>& seconds) {
+		double median = percentile(seconds, 50);
+		std::printf("%-10s %12.3f %12.3f %12.3f %12.3f %16.0f\n", name, median * 1e3, percentile(seconds, 90) * 1e3,
+			percentile(seconds, 99) * 1e3, percentile(seconds, 0) * 1e3, median > 0 ? static_cast<double>(roads) / median : 0.0);
+	};
+	for (const Stage& stage : stages) {
+		report(stage.name, stage.seconds);
+		for (std::size_t run = 0; run < runs; run++) total[run] += stage.seconds[run];
+	}
+	report("total", total);
+}
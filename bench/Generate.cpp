@@ -0,0 +1,43 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "SyntheticMap.h"
+
+int main(int argc, char* argv[]) {
+	// Opções de geração do mapa (`SyntheticMap::usage`), mais:
+	// -o ARQUIVO: escreve o mapa no arquivo em vez da saída padrão.
+	SyntheticMap::Options options;
+	std::string output;
+	bool valid = argc % 2 == 1;
+	for (int i = 1; valid && i + 1 < argc; i += 2) {
+		if (std::strcmp(argv[i], "-o") == 0) output = argv[i + 1];
+		else valid = SyntheticMap::parseOption(argv[i], argv[i + 1], options);
+	}
+	if (!valid || !SyntheticMap::isValid(options)) {
+		std::cerr << "Uso: " << argv[0] << " [opcoes]\n" << SyntheticMap::usage()
+			<< "  -o ARQUIVO       escreve o mapa no arquivo em vez da saida padrao\n";
+		return 1;
+	}
+
+	SyntheticMap map = SyntheticMap::generate(options);
+	if (output.empty()) {
+		std::ios::sync_with_stdio(false);
+		map.write(std::cout);
+		std::cout.flush();
+		return std::cout ? 0 : 1;
+	}
+
+	std::ofstream out(output);
+	if (!out) {
+		std::cerr << "Nao foi possivel criar o arquivo " << output << std::endl;
+		return 1;
+	}
+	map.write(out);
+	out.close();
+	if (!out) {
+		std::cerr << "Nao foi possivel escrever o arquivo " << output << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,341 @@
+#include "SyntheticMap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <random>
+
+namespace {
+	/**
+	 * \brief Números aleatórios reproduzíveis em qualquer implementação da biblioteca padrão.
+	 */
+	class Random {
+	public:
+		explicit Random(std::uint64_t seed) : m_engine(seed) {}
+
+		/**
+		 * \brief Sorteia um inteiro em [0, n).
+		 */
+		std::size_t below(std::size_t n) { return static_cast<std::size_t>(m_engine() % n); }
+
+		/**
+		 * \brief Sorteia um real em [0, 1) com os 53 bits mais altos.
+		 */
+		double unit() { return static_cast<double>(m_engine() >> 11) * 0x1.0p-53; }
+
+		/**
+		 * \brief Sorteia uma cidade em [0, n) diferente de `city`.
+		 */
+		CityId other(std::size_t n, CityId city) {
+			CityId target = static_cast<CityId>(below(n - 1));
+			return target >= city ? target + 1 : target;
+		}
+
+		/**
+		 * \brief Embaralha um vetor (Fisher-Yates).
+		 */
+		template <typename T>
+		void shuffle(std::vector<T>& values) {
+			for (std::size_t i = values.size(); i > 1; i--)
+				std::swap(values[i - 1], values[below(i)]);
+		}
+
+	private:
+		std::mt19937_64 m_engine;
+	};
+
+	/**
+	 * \brief As cidades de 0 a n - 1 em ordem sorteada.
+	 */
+	std::vector<CityId> permutation(std::size_t n, Random& random) {
+		std::vector<CityId> order(n);
+		for (std::size_t i = 0; i < n; i++)
+			order[i] = static_cast<CityId>(i);
+		random.shuffle(order);
+		return order;
+	}
+
+	/**
+	 * \brief Sementes diferentes para o modelo, o embaralhamento das estradas e os pesos.
+	 */
+	constexpr std::uint64_t SHUFFLE_STREAM = 0x9E3779B97F4A7C15ull;
+	constexpr std::uint64_t WEIGHT_STREAM = 0xC2B2AE3D27D4EB4Full;
+
+	template <typename T>
+	bool parseNumber(std::string_view text, T& value) {
+		auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc() && end == text.data() + text.size();
+	}
+}
+
+SyntheticMap::SyntheticMap(std::size_t cities, std::vector<Edge> roads, std::uint64_t seed)
+	: m_cities(cities), m_roads(std::move(roads)) {
+	Random random(seed ^ SHUFFLE_STREAM);
+	random.shuffle(m_roads);
+}
+
+SyntheticMap SyntheticMap::generate(const Options& options) {
+	assert(isValid(options));
+
+	SyntheticMap map = [&] {
+		switch (options.model) {
+		case Model::GRID: {
+			// A grade mais quadrada com no máximo `cities` cidades.
+			std::size_t rows = static_cast<std::size_t>(std::sqrt(static_cast<double>(options.cities)));
+			return grid(rows, options.cities / rows, options.seed);
+		}
+		case Model::CHAIN:
+			return chain(options.cities, options.seed);
+		case Model::POWER_LAW:
+			return powerLaw(options.cities, options.degree, options.exponent, options.seed);
+		case Model::COMPONENTS:
+			return components(options.cities, options.components, options.skew, options.degree, options.seed);
+		case Model::RANDOM:
+		default:
+			return random(options.cities, options.degree, options.seed);
+		}
+	}();
+
+	if (options.maxWeight > 1) map.weigh(options.maxWeight, options.seed);
+	return map;
+}
+
+SyntheticMap SyntheticMap::random(std::size_t cities, double degree, std::uint64_t seed) {
+	assert(cities >= 2 && degree >= 1);
+	Random random(seed);
+
+	std::size_t count = static_cast<std::size_t>(static_cast<double>(cities) * degree);
+	std::vector<Edge> roads;
+	roads.reserve(count);
+
+	for (CityId city = 0; city < cities; city++)
+		roads.push_back({ city, random.other(cities, city) });
+
+	while (roads.size() < count) {
+		CityId source = static_cast<CityId>(random.below(cities));
+		roads.push_back({ source, random.other(cities, source) });
+	}
+
+	return SyntheticMap(cities, std::move(roads), seed);
+}
+
+SyntheticMap SyntheticMap::grid(std::size_t rows, std::size_t columns, std::uint64_t seed) {
+	assert(rows >= 2 && columns >= 2);
+	Random random(seed);
+	auto cell = [columns](std::size_t row, std::size_t column) { return static_cast<CityId>(row * columns + column); };
+
+	std::vector<Edge> roads;
+	roads.reserve(rows * (columns - 1) + columns * (rows - 1));
+
+	// Cada rua anda em um único sentido, sorteado por rua.
+	for (std::size_t row = 0; row < rows; row++) {
+		bool east = random.below(2) == 0;
+		for (std::size_t column = 0; column + 1 < columns; column++) {
+			CityId west = cell(row, column), next = cell(row, column + 1);
+			roads.push_back(east ? Edge{ west, next } : Edge{ next, west });
+		}
+	}
+
+	for (std::size_t column = 0; column < columns; column++) {
+		bool south = random.below(2) == 0;
+		for (std::size_t row = 0; row + 1 < rows; row++) {
+			CityId north = cell(row, column), next = cell(row + 1, column);
+			roads.push_back(south ? Edge{ north, next } : Edge{ next, north });
+		}
+	}
+
+	return SyntheticMap(rows * columns, std::move(roads), seed);
+}
+
+SyntheticMap SyntheticMap::chain(std::size_t cities, std::uint64_t seed) {
+	assert(cities >= 2);
+	Random random(seed);
+	std::vector<CityId> order = permutation(cities, random);
+
+	std::vector<Edge> roads;
+	roads.reserve(cities - 1);
+	for (std::size_t i = 0; i + 1 < cities; i++)
+		roads.push_back({ order[i], order[i + 1] });
+
+	return SyntheticMap(cities, std::move(roads), seed);
+}
+
+SyntheticMap SyntheticMap::powerLaw(std::size_t cities, double degree, double exponent, std::uint64_t seed) {
+	assert(cities >= 2 && degree >= 1 && exponent > 2);
+	Random random(seed);
+	std::vector<CityId> city = permutation(cities, random);
+
+	// Peso acumulado dos postos; o destino é o posto onde cai um sorteio uniforme sobre o total.
+	std::vector<double> cumulative(cities);
+	double total = 0;
+	for (std::size_t rank = 0; rank < cities; rank++) {
+		total += std::pow(static_cast<double>(rank + 1), -1 / (exponent - 1));
+		cumulative[rank] = total;
+	}
+
+	auto target = [&](CityId source) {
+		while (true) {
+			auto rank = std::upper_bound(cumulative.begin(), cumulative.end(), random.unit() * total) - cumulative.begin();
+			CityId node = city[std::min(static_cast<std::size_t>(rank), cities - 1)];
+			if (node != source) return node;
+		}
+	};
+
+	std::size_t count = static_cast<std::size_t>(static_cast<double>(cities) * degree);
+	std::vector<Edge> roads;
+	roads.reserve(count);
+
+	for (CityId source = 0; source < cities; source++)
+		roads.push_back({ source, target(source) });
+
+	while (roads.size() < count) {
+		CityId source = static_cast<CityId>(random.below(cities));
+		roads.push_back({ source, target(source) });
+	}
+
+	return SyntheticMap(cities, std::move(roads), seed);
+}
+
+SyntheticMap SyntheticMap::components(std::size_t cities, std::size_t count, double skew, double degree, std::uint64_t seed) {
+	assert(cities >= 2 && count >= 1 && count <= cities && skew >= 0 && degree >= 1);
+	Random random(seed);
+
+	// Tamanhos proporcionais a (i + 1)^-skew, com pelo menos uma cidade cada; a sobra (ou a falta, pelo
+	// arredondamento para 1) é acertada nas maiores componentes. A ordem dos tamanhos é sorteada.
+	std::vector<double> share(count);
+	double total = 0;
+	for (std::size_t i = 0; i < count; i++)
+		total += share[i] = std::pow(static_cast<double>(i + 1), -skew);
+
+	std::vector<std::size_t> sizes(count);
+	std::size_t assigned = 0;
+	for (std::size_t i = 0; i < count; i++)
+		assigned += sizes[i] = std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(cities) * share[i] / total));
+
+	sizes[0] += cities > assigned ? cities - assigned : 0;
+	for (std::size_t i = 0; assigned > cities; i = (i + 1) % count) {
+		if (sizes[i] > 1) {
+			sizes[i]--;
+			assigned--;
+		}
+	}
+	random.shuffle(sizes);
+
+	std::vector<CityId> order = permutation(cities, random);
+	std::vector<std::size_t> offsets(count + 1, 0);
+	for (std::size_t i = 0; i < count; i++)
+		offsets[i + 1] = offsets[i] + sizes[i];
+	auto member = [&](std::size_t component) { return order[offsets[component] + random.below(sizes[component])]; };
+
+	std::vector<Edge> roads;
+	roads.reserve(static_cast<std::size_t>(static_cast<double>(cities) * degree) + 2 * count);
+
+	// Dentro de cada componente: um ciclo e estradas sorteadas até o grau médio.
+	for (std::size_t component = 0; component < count; component++) {
+		std::size_t size = sizes[component];
+		if (size < 2) continue;
+
+		const CityId* members = order.data() + offsets[component];
+		for (std::size_t i = 0; i < size; i++)
+			roads.push_back({ members[i], members[(i + 1) % size] });
+
+		std::size_t extra = static_cast<std::size_t>((degree - 1) * static_cast<double>(size));
+		for (std::size_t i = 0; i < extra; i++) {
+			std::size_t from = random.below(size);
+			std::size_t to = random.other(size, static_cast<CityId>(from));
+			roads.push_back({ members[from], members[to] });
+		}
+	}
+
+	// Entre componentes, só para frente: toda componente recebe uma estrada de uma anterior, e outras
+	// tantas estradas ligam pares sorteados.
+	for (std::size_t component = 1; component < count; component++)
+		roads.push_back({ member(random.below(component)), member(component) });
+
+	for (std::size_t i = 1; i < count; i++) {
+		std::size_t from = random.below(count - 1);
+		std::size_t to = from + 1 + random.below(count - 1 - from);
+		roads.push_back({ member(from), member(to) });
+	}
+
+	return SyntheticMap(cities, std::move(roads), seed);
+}
+
+void SyntheticMap::weigh(Weight maxWeight, std::uint64_t seed) {
+	Random random(seed ^ WEIGHT_STREAM);
+	for (Edge& road : m_roads)
+		road.weight = static_cast<Weight>(1 + random.below(maxWeight));
+}
+
+bool SyntheticMap::parseOption(std::string_view name, std::string_view value, Options& options) {
+	if (name == "--model") {
+		if (value == "random") options.model = Model::RANDOM;
+		else if (value == "grid") options.model = Model::GRID;
+		else if (value == "chain") options.model = Model::CHAIN;
+		else if (value == "power-law") options.model = Model::POWER_LAW;
+		else if (value == "components") options.model = Model::COMPONENTS;
+		else return false;
+		return true;
+	}
+
+	if (name == "--cities") return parseNumber(value, options.cities);
+	if (name == "--degree") return parseNumber(value, options.degree);
+	if (name == "--exponent") return parseNumber(value, options.exponent);
+	if (name == "--components") return parseNumber(value, options.components);
+	if (name == "--skew") return parseNumber(value, options.skew);
+	if (name == "--max-weight") return parseNumber(value, options.maxWeight);
+	if (name == "--seed") return parseNumber(value, options.seed);
+	return false;
+}
+
+bool SyntheticMap::isValid(const Options& options) {
+	std::size_t minimum = options.model == Model::GRID ? 4 : 2;
+	return options.cities >= minimum && options.cities < NO_CITY && options.degree >= 1
+		&& options.exponent > 2 && options.skew >= 0
+		&& (options.model != Model::COMPONENTS || (options.components >= 1 && options.components <= options.cities)) && options.maxWeight >= 1;
+}
+
+const char* SyntheticMap::usage() {
+	return
+		"  --model M        random, grid, chain, power-law ou components (random)\n"
+		"  --cities N       numero de cidades; a grade arredonda para linhas * colunas (100000)\n"
+		"  --degree D       estradas por cidade em random, power-law e components (4)\n"
+		"  --exponent G     expoente da lei de potencia dos graus de entrada, maior que 2 (2.5)\n"
+		"  --components C   numero de componentes fortemente conectadas em components (100)\n"
+		"  --skew S         tamanho da i-esima componente proporcional a (i + 1)^-S; 0 iguala os tamanhos (1)\n"
+		"  --max-weight W   pesos sorteados entre 1 e W; 1 gera um mapa sem pesos (1)\n"
+		"  --seed S         semente do gerador (1)\n";
+}
+
+std::string SyntheticMap::name(CityId city) {
+	return "c" + std::to_string(city);
+}
+
+void SyntheticMap::write(std::ostream& out) const {
+	out << m_cities << ' ' << m_roads.size() << '\n';
+
+	// As linhas são montadas em um bloco e escritas de uma vez, sem uma string por nome.
+	std::vector<char> block;
+	block.reserve(1 << 20);
+	char digits[16];
+	auto append = [&](char prefix, std::uint32_t value) {
+		block.push_back(prefix);
+		auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+		block.insert(block.end(), digits, end);
+	};
+
+	for (const Edge& road : m_roads) {
+		append('c', road.source);
+		block.push_back(' ');
+		append('c', road.target);
+		if (road.weight != 1) append(' ', road.weight);
+		block.push_back('\n');
+
+		if (block.size() >= (1 << 20) - 64) {
+			out.write(block.data(), static_cast<std::streamsize>(block.size()));
+			block.clear();
+		}
+	}
+	out.write(block.data(), static_cast<std::streamsize>(block.size()));
+}
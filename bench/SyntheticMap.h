@@ -0,0 +1,169 @@
+#ifndef SyntheticMap_H
+#define SyntheticMap_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Graph.h"
+
+/**
+ * \class SyntheticMap
+ * \brief Mapa gerado a partir de uma semente, no formato de entrada do programa.
+ *
+ * As mesmas opes geram sempre o mesmo mapa: os nmeros aleatrios vm de um
+ * `std::mt19937_64`, reduzidos por mdulo ou convertidos em `double` pelos 53 bits mais
+ * altos, sem as distribuies da biblioteca padro, cujo resultado muda entre implementaes.
+ *
+ * Toda cidade aparece em pelo menos uma estrada, j que a entrada s declara as cidades
+ * pelas estradas, e nenhuma estrada liga uma cidade a ela mesma. A cidade `i` se chama
+ * `c<i>`. As estradas so embaralhadas no fim, ento a ordem em que as cidades aparecem no
+ * arquivo (e os seus identificadores no programa) no segue a estrutura do modelo.
+ *
+ * As estradas ficam em memria, 12 bytes cada: 10 milhes de cidades com grau 4 ocupam
+ * cerca de 500 MB.
+ */
+class SyntheticMap {
+public:
+	/**
+	 * \brief Modelo de gerao do mapa.
+	 */
+	enum class Model {
+		// Digrafo aleatrio esparso.
+		RANDOM,
+		// Grade com ruas de mo nica.
+		GRID,
+		// Um nico caminho passando por todas as cidades.
+		CHAIN,
+		// Destinos sorteados por uma lei de potncia: poucas cidades concentram as estradas.
+		POWER_LAW,
+		// Componentes fortemente conectadas com nmero e tamanhos controlados.
+		COMPONENTS
+	};
+
+	/**
+	 * \brief Opes de gerao, lidas da linha de comando por `parseOption`.
+	 */
+	struct Options {
+		Model model = Model::RANDOM;
+
+		// Nmero de cidades. A grade arredonda para linhas * colunas.
+		std::size_t cities = 100000;
+
+		// Nmero mdio de estradas saindo de cada cidade (RANDOM, POWER_LAW, COMPONENTS).
+		double degree = 4;
+
+		// Expoente da lei de potncia dos graus de entrada (POWER_LAW), maior que 2.
+		double exponent = 2.5;
+
+		// Nmero de componentes (COMPONENTS), de 1 at `cities`.
+		std::size_t components = 100;
+
+		// Expoente dos tamanhos das componentes: o tamanho da i-sima  proporcional a (i + 1)^-skew.
+		// Com 0, as componentes tm o mesmo tamanho.
+		double skew = 1;
+
+		// Maior peso das estradas; com 1, o mapa no tem pesos.
+		Weight maxWeight = 1;
+
+		std::uint64_t seed = 1;
+	};
+
+	/**
+	 * \brief Gera um mapa.
+	 *
+	 * \note Complexidade: O(V + E), mais O(E * log(V)) para a lei de potncia.
+	 */
+	static SyntheticMap generate(const Options& options);
+
+	/**
+	 * \brief Digrafo aleatrio esparso.
+	 *
+	 * A cidade `i` tem uma estrada para uma cidade sorteada, e as demais estradas ligam pares sorteados.
+	 */
+	static SyntheticMap random(std::size_t cities, double degree, std::uint64_t seed);
+
+	/**
+	 * \brief Grade de `rows` por `columns` cidades, com ruas de mo nica.
+	 *
+	 * Cada linha e cada coluna  uma rua com um sentido sorteado, e cada cidade tem uma estrada para
+	 * a vizinha seguinte na sua linha e na sua coluna, exceto no fim da rua. `rows` e `columns` so
+	 * pelo menos 2.
+	 */
+	static SyntheticMap grid(std::size_t rows, std::size_t columns, std::uint64_t seed);
+
+	/**
+	 * \brief Um caminho com todas as cidades em uma ordem sorteada: a DFS chega a V cidades de profundidade.
+	 */
+	static SyntheticMap chain(std::size_t cities, std::uint64_t seed);
+
+	/**
+	 * \brief Destinos sorteados com probabilidade proporcional a (posto + 1)^(-1 / (exponent - 1)), como no
+	 *        modelo de Chung e Lu: os graus de entrada seguem uma lei de potncia com esse expoente, e as
+	 *        origens so uniformes. A cidade com cada posto  sorteada.
+	 */
+	static SyntheticMap powerLaw(std::size_t cities, double degree, double exponent, std::uint64_t seed);
+
+	/**
+	 * \brief Exatamente `count` componentes fortemente conectadas.
+	 *
+	 * As cidades, em ordem sorteada, so divididas em componentes de tamanhos proporcionais a
+	 * (i + 1)^-skew, com pelo menos uma cidade cada. As cidades de uma componente formam um ciclo,
+	 * mais estradas internas sorteadas at o grau mdio. Entre componentes, as estradas s vo de
+	 * uma componente para outra posterior, e toda componente recebe uma estrada de alguma anterior:
+	 * a primeira componente  a nica fonte e alcana todas as outras.
+	 */
+	static SyntheticMap components(std::size_t cities, std::size_t count, double skew, double degree, std::uint64_t seed);
+
+	/**
+	 * \brief Sorteia o peso de cada estrada entre 1 e `maxWeight`.
+	 */
+	void weigh(Weight maxWeight, std::uint64_t seed);
+
+	/**
+	 * \brief L uma opo de gerao, como `--model grid` ou `--cities 1000`.
+	 *
+	 * \return Falso se `name` no for uma opo de gerao ou se `value` for invlido.
+	 */
+	static bool parseOption(std::string_view name, std::string_view value, Options& options);
+
+	/**
+	 * \brief Verifica se as opes descrevem um mapa que pode ser gerado.
+	 */
+	static bool isValid(const Options& options);
+
+	/**
+	 * \brief Descreve as opes de gerao, para as mensagens de uso.
+	 */
+	static const char* usage();
+
+	/**
+	 * \brief Obtm o nmero de cidades.
+	 */
+	std::size_t cityCount() const { return m_cities; }
+
+	/**
+	 * \brief Obtm as estradas, na ordem em que so escritas.
+	 */
+	const std::vector<Edge>& roads() const { return m_roads; }
+
+	/**
+	 * \brief Obtm o nome de uma cidade.
+	 */
+	static std::string name(CityId city);
+
+	/**
+	 * \brief Escreve o mapa no formato de entrada: `V E` e uma estrada `A B` (ou `A B peso`) por linha.
+	 */
+	void write(std::ostream& out) const;
+
+private:
+	SyntheticMap(std::size_t cities, std::vector<Edge> roads, std::uint64_t seed);
+
+	std::size_t m_cities;
+	std::vector<Edge> m_roads;
+};
+
+#endif // SyntheticMap_H
@@ -1,31 +1,22 @@
 #ifndef ALGORITHMS_H
 #define ALGORITHMS_H
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 #include <queue>
 #include <unordered_map>
 
 #include "Archadian.h"
-
-enum CityColor {
-	// No foi descobreto.
-	UNDISCOVERED,
-	// Descoberto mas no finalizado.
-	DISCOVERED,
-	// Finalizado.
-	FINISHED
-};
-
+#include "Components.h"
+#include "SearchWorkspace.h"
+#include "ShortestPathTree.h"
+#include "TraversalState.h"
 
 using CityHash = City::CityHash;
 using CityEqual = City::CityEqual;
-using DiscoveryTime = std::size_t;
-using FinishingTime = std::size_t;
-using DFS_DATA = std::tuple<
-	std::unordered_map<City*, CityColor, CityHash, CityEqual>,
-	std::unordered_map<City*, DiscoveryTime, CityHash, CityEqual>,
-	std::unordered_map<City*, FinishingTime, CityHash, CityEqual>>;
+using DFS_DATA = TraversalState;
 using SCC = std::vector<City>;
 
 /**
@@ -118,18 +109,19 @@ public:
 	/**
 	 * \brief Realiza uma busca em profundidade (DFS) em um grafo.
 	 *
-	 * Este mtodo percorre o grafo comeando a partir de um n inicial e visita recursivamente
+	 * Este mtodo percorre o grafo comeando a partir de um n inicial e visita
 	 * todos os ns conectados, registrando informaes como tempos de descoberta e finalizao.
+	 * A travessia  feita diretamente sobre o grafo CSR do 'Archadian', com uma pilha explcita
+	 * no lugar da recurso, e por isso suporta cadeias de estradas de qualquer profundidade.
 	 *
 	 * \param Archadian Um ponteiro para o objeto 'Archadian' que contm os ns e arestas a serem percorridos.
 	 *                  Este objeto representa o grafo sobre o qual a DFS ser executada.
 	 * \param nodeVisitor Um ponteiro para uma funo ou objeto que ser chamado em cada n visitado.
 	 *                    Permite a execuo de aes especficas durante a visita a cada n.
 	 *
-	 * \return Um `DFS_DATA` contendo trs mapas:
-	 *         - Um mapa que associa cada n (City) ao seu estado (`CityColor`).
-	 *         - Um mapa que associa cada n ao seu tempo de descoberta (`DiscoveryTime`).
-	 *         - Um mapa que associa cada n ao seu tempo de finalizao (`FinishingTime`).
+	 * \return Um `DFS_DATA` com a cor (`CityColor`) e os tempos de descoberta (`DiscoveryTime`) e
+	 *         finalizao (`FinishingTime`) de cada n, indexados pelo identificador do n (`Archadian::getId`),
+	 *         e a ordem de finalizao dos ns (`TraversalState::getPostorder`).
 	 *
 	 * \note Complexidade: O(V + E), onde V  o nmero de ns (vrtices) e E  o nmero de arestas do grafo.
 	 *       A DFS percorre todos os ns e arestas uma nica vez.
@@ -147,22 +139,34 @@ public:
 	 * \param nodeVisitor Um ponteiro para uma funo ou objeto que ser chamado em cada n visitado.
 	 *                    Permite a execuo de aes especficas durante a visita a cada n.
 	 *
-	 * \return Um `DFS_DATA` contendo trs mapas:
-	 *         - Um mapa que associa cada n (City) ao seu estado (`CityColor`).
-	 *         - Um mapa que associa cada n ao seu tempo de descoberta (`DiscoveryTime`).
-	 *         - Um mapa que associa cada n ao seu tempo de finalizao (`FinishingTime`).
+	 * \return Um `DFS_DATA` com a cor e os tempos de descoberta e finalizao de cada n,
+	 *         indexados pela posio do n em `visitingNodes`.
 	 *
 	 * \note Complexidade: O(V + E), onde V  o nmero de ns visitados e E  o nmero de arestas conectadas
 	 *       aos ns visitados. A DFS percorre apenas os ns e arestas acessveis a partir dos ns fornecidos.
 	 */
 	static DFS_DATA DFS(std::vector<City>& visitingNodes, NodeVisitor* nodeVisitor);
 
+	/**
+	 * \brief Realiza uma busca em profundidade (DFS) diretamente sobre um grafo CSR.
+	 *
+	 * \param graph O grafo a ser percorrido.
+	 * \param order Ordem em que as cidades iniciam uma nova rvore da DFS.
+	 * \param state Estado reaproveitado pela busca.  reiniciado antes da travessia e, ao final,
+	 *              contm as cores, os tempos de descoberta e finalizao de cada cidade e a
+	 *              ps-ordem da busca (`TraversalState::getPostorder`).
+	 *
+	 * \note Complexidade: O(V + E), onde V  o nmero de ns e E  o nmero de arestas do grafo.
+	 */
+	static void DFS(const Graph& graph, const std::vector<CityId>& order, TraversalState& state);
+
 	/**
 	 * \brief Realiza a transposio de um grafo, invertendo a direo de todas as arestas.
 	 *
 	 * Este mtodo inverte as arestas do grafo, tornando o n de destino de cada aresta o novo n de origem,
 	 * e o n de origem o novo destino. Essa operao  usada em algoritmos como o de Kosaraju para encontrar
-	 * componentes fortemente conectadas.
+	 * componentes fortemente conectadas. Tanto as `Road`s de cada `City` quanto o grafo CSR
+	 * (`Archadian::setGraph`) so transpostos.
 	 *
 	 * \param Archadian O grafo a ser transposto.
 	 *
@@ -184,6 +188,35 @@ public:
 	 */
 	static std::vector<SCC> Kosaraju(Archadian* Archadian);
 
+	/**
+	 * \brief Encontra componentes fortemente conectadas diretamente sobre um grafo CSR.
+	 *
+	 * \param graph O grafo a ser processado. O grafo no  alterado; a segunda passada usa `graph.transpose()`.
+	 * \param order Ordem em que as cidades iniciam a primeira DFS. Deve conter todas as cidades do grafo.
+	 *
+	 * \return Um vetor de componentes, cada uma com os identificadores de suas cidades. A primeira cidade
+	 *         de cada componente  a raiz encontrada na segunda passada.
+	 *
+	 * \note Complexidade: O(V + E), onde V  o nmero de ns e E  o nmero de arestas do grafo.
+	 */
+	static std::vector<std::vector<CityId>> Kosaraju(const Graph& graph, const std::vector<CityId>& order);
+
+	/**
+	 * \brief Encontra componentes fortemente conectadas usando o algoritmo de Pearce.
+	 *
+	 * Variante de Tarjan com uso reduzido de memria: uma nica DFS iterativa calcula os lowlinks
+	 * (`rindex`), guardados em um nico inteiro por cidade, sem transpor nem alterar o grafo.
+	 *
+	 * \param graph O grafo a ser processado.
+	 * \param order Ordem em que as cidades iniciam a DFS. Deve conter todas as cidades do grafo.
+	 *
+	 * \return As componentes em ordem topolgica. Para a mesma `order`, as componentes, a sua ordem
+	 *         e as suas razes so as mesmas retornadas por `Kosaraju`.
+	 *
+	 * \note Complexidade: O(V + E), com uma nica passada sobre as arestas.
+	 */
+	static Components Pearce(const Graph& graph, const std::vector<CityId>& order);
+
 	/**
 	 * \brief Calcula os caminhos mais curtos de um n fonte para todos os outros ns em um grafo usando o algoritmo de Dijkstra.
 	 *
@@ -192,11 +225,135 @@ public:
 	 * \param Archadian Um ponteiro para o objeto 'Archadian' contendo os ns e arestas.
 	 * \param source O n de origem a partir do qual os caminhos sero calculados.
 	 *
-	 * \return Um mapa que associa cada n acessvel a partir da origem com o vetor de cidades que compem o caminho mais curto.
+	 * \return A rvore de caminhos mais curtos, indexada pelo identificador da cidade em `Archadian` (`Archadian::getId`),
+	 *         ou uma rvore vazia se a origem no fizer parte do grafo.
+	 *
+	 * \note Complexidade: a mesma da verso sobre o grafo CSR.
+	 */
+	static ShortestPathTree Dijkstra(Archadian* Archadian, City& source);
+
+	/**
+	 * \brief Calcula os caminhos mais curtos de uma cidade para todas as outras diretamente sobre um grafo CSR.
+	 *
+	 * \param graph O grafo contendo as cidades e estradas.
+	 * \param source A cidade de origem.
+	 *
+	 * \return A rvore com a distncia e o predecessor de cada cidade. Os caminhos so percorridos sob demanda
+	 *         (`ShortestPathTree::walk`, `ShortestPathTree::path`). Entre caminhos de mesmo peso, cada cidade vem
+	 *         do predecessor de menor distncia e, depois, de menor identificador.
 	 *
-	 * \note Complexidade: O((V + E) * log(V)), onde V  o nmero de ns e E  o nmero de arestas do grafo.
+	 * \note Complexidade: O(V + E + D) com pesos at `BucketQueue::MAX_BUCKETS`, onde D  a maior distncia;
+	 *       O((V + E) * log(V)) com pesos maiores. A rvore ocupa O(V), independente do tamanho dos caminhos.
 	 */
-	static std::unordered_map<City*, std::vector<City*>, CityHash, CityEqual> Dijkstra(Archadian* Archadian, City& source);
+	static ShortestPathTree Dijkstra(const Graph& graph, CityId source);
+
+	/**
+	 * \brief Calcula as distncias e os predecessores a partir de uma cidade, reaproveitando o estado de buscas anteriores.
+	 *
+	 * \param graph O grafo contendo as cidades e estradas.
+	 * \param source A cidade de origem.
+	 * \param workspace Recebe a distncia e o predecessor de cada cidade alcanada, com o mesmo desempate da
+	 *                  verso que devolve os caminhos. As cidades alcanadas ficam em `SearchWorkspace::touched`.
+	 *
+	 * \note Complexidade: a mesma da verso que devolve os caminhos, sem o O(V) de preparar o estado: s as
+	 *       cidades alcanadas so escritas.
+	 */
+	static void Dijkstra(const Graph& graph, CityId source, SearchWorkspace& workspace);
+
+	/**
+	 * \brief Encontra um caminho mais curto entre duas cidades, buscando a partir das duas pontas.
+	 *
+	 * \param graph O grafo contendo as cidades e estradas.
+	 * \param reverse O mesmo grafo com as estradas invertidas (`Graph::transpose`).
+	 * \param source A cidade de origem.
+	 * \param target A cidade de destino.
+	 * \param forward Estado da busca a partir da origem.
+	 * \param backward Estado da busca a partir do destino.
+	 * \param path Recebe as cidades do caminho, da origem at o destino, incluindo as duas.
+	 *
+	 * \return Falso se o destino no for alcanvel; `path` fica vazio.
+	 *
+	 * \note Complexidade: a mesma do Dijkstra no pior caso, mas s sobre as cidades mais prximas de uma das
+	 *       pontas que o meio do caminho. Entre caminhos de mesmo peso, qualquer um pode ser devolvido.
+	 */
+	static bool ShortestPath(const Graph& graph, const Graph& reverse, CityId source, CityId target,
+		SearchWorkspace& forward, SearchWorkspace& backward, std::vector<CityId>& path);
+
+	/**
+	 * \brief Busca bidirecional de `ShortestPath` sobre qualquer representao do grafo.
+	 *
+	 * As duas buscas so Dijkstras com a fila de baldes, e cada passo fixa uma cidade do lado que
+	 * fixou a menor distncia at agora. Toda estrada relaxada cuja ponta j foi alcanada pelo
+	 * outro lado fecha um caminho; a busca para quando a soma das distncias fixadas dos dois lados
+	 * alcana o menor caminho fechado, pois qualquer caminho ainda no visto passa por uma cidade
+	 * no fixada em nenhum dos lados.
+	 *
+	 * \tparam Out Chamado como `out(node, visit)`; chama `visit(vizinha, peso)` para cada estrada que sai de `node`.
+	 * \tparam In O mesmo para as estradas que chegam em `node`, com `visit(origem, peso)`.
+	 *
+	 * \param size Nmero de cidades do grafo.
+	 * \param maxWeight O maior peso das estradas.
+	 *
+	 * As estradas omitidas por `out` ou `in` so ignoradas, o que permite podar a busca.
+	 */
+	template <typename Out, typename In>
+	static bool BidirectionalSearch(CityId source, CityId target, std::size_t size, Weight maxWeight,
+		SearchWorkspace& forward, SearchWorkspace& backward, Out out, In in, std::vector<CityId>& path) {
+		path.clear();
+		forward.start(size);
+		backward.start(size);
+		forward.reach(source, 0, NO_CITY);
+		backward.reach(target, 0, NO_CITY);
+
+		Distance best = source == target ? 0 : SearchWorkspace::UNREACHED;
+		CityId meeting = source;
+
+		BucketQueue& forwardQueue = forward.queue(maxWeight);
+		BucketQueue& backwardQueue = backward.queue(maxWeight);
+		forwardQueue.push(source, 0);
+		backwardQueue.push(target, 0);
+
+		// ltima distncia fixada de cada lado; as prximas no so menores.
+		Distance forwardRadius = 0, backwardRadius = 0;
+
+		while (!forwardQueue.empty() && !backwardQueue.empty() && forwardRadius + backwardRadius < best) {
+			const bool isForward = forwardRadius <= backwardRadius;
+			SearchWorkspace& side = isForward ? forward : backward;
+			SearchWorkspace& other = isForward ? backward : forward;
+			BucketQueue& queue = isForward ? forwardQueue : backwardQueue;
+
+			Distance distance;
+			CityId node = queue.pop(distance);
+			if (distance > side.distance(node)) continue;
+			side.settle(node);
+			(isForward ? forwardRadius : backwardRadius) = distance;
+
+			auto visit = [&](CityId neighbor, Weight weight) {
+				Distance next = distance + weight;
+				if (next < side.distance(neighbor)) {
+					side.reach(neighbor, next, node);
+					queue.push(neighbor, next);
+				}
+				if (other.reached(neighbor) && side.distance(neighbor) + other.distance(neighbor) < best) {
+					best = side.distance(neighbor) + other.distance(neighbor);
+					meeting = neighbor;
+				}
+			};
+
+			if (isForward) out(node, visit);
+			else in(node, visit);
+		}
+
+		if (best == SearchWorkspace::UNREACHED) return false;
+
+		// Da cidade de encontro para trs at a origem, e depois para frente at o destino.
+		for (CityId node = meeting; node != NO_CITY; node = forward.parent(node))
+			path.push_back(node);
+		std::reverse(path.begin(), path.end());
+		for (CityId node = backward.parent(meeting); node != NO_CITY; node = backward.parent(node))
+			path.push_back(node);
+		return true;
+	}
 
 	/**
 	 * \brief Move o elemento especificado para a primeira posio no vetor,
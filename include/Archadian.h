@@ -1,12 +1,25 @@
 #ifndef Archadian_H
 #define Archadian_H
 
+#include <span>
+#include <string_view>
 #include <vector>
 
 #include "City.h"
+#include "Components.h"
+#include "Condensation.h"
+#include "Graph.h"
+#include "NameTable.h"
 
-using Battalions = std::vector<City>;
-using Patrolling = std::vector<City>;
+/**
+ * \brief Cidades onde ficam os batalhes, como identificadores no grafo.
+ */
+using Battalions = std::span<const CityId>;
+
+/**
+ * \brief Rota de uma patrulha, como identificadores das cidades no grafo.
+ */
+using Patrolling = std::span<const CityId>;
 
 /**
  * \class Archadian
@@ -36,30 +49,59 @@ public:
 	 */
 	Archadian(const std::vector<City>& nodes);
 
+	/**
+	 * \brief Construtor da classe Archadian com as cidades e um grafo CSR j construdo.
+	 *
+	 * \param nodes Vetor contendo as cidades, na ordem dos identificadores usados em `graph`.
+	 * \param graph Grafo com as estradas entre as cidades.
+	 * \param names Tabela com os nomes referenciados por `City::getNameId`.
+	 *
+	 * Este construtor evita que as estradas sejam armazenadas em cada `City`, sendo o
+	 * caminho usado pela leitura do mapa.
+	 */
+	Archadian(std::vector<City> nodes, Graph graph, NameTable names = NameTable());
+
 	/**
 	 * \brief Calcula a cidade capital do grafo.
 	 *
-	 * Este mtodo utiliza o algoritmo de Dijkstra para determinar a cidade capital,
-	 * que  definida como o n mais central ou estratgico do grafo.
+	 * Este mtodo utiliza BFSs a partir de cada cidade, 64 de cada vez (`CapitalFinder`), para determinar a cidade capital,
+	 * que  definida como o n mais central ou estratgico do grafo. Em caso de empate,
+	 * a cidade que aparece primeiro em `getNodes()`  escolhida.
+	 *
+	 * Se as estradas tiverem pesos, as distncias so pesos de caminhos e cada cidade  avaliada por um
+	 * Dijkstra prprio, com a fila de baldes (`BucketQueue`).
+	 *
+	 * Os candidatos vm da condensao do grafo (`getCondensation`), calculada aqui e guardada para
+	 * `calcBattalionsAndPatrolling`.
+	 *
+	 * \note Complexidade: O(V / 64 * D * (V + E)), onde V  o nmero de ns (Citys), E  o nmero de arestas
+	 *       e D  o dimetro do grafo. Com pesos, O(V * (V + E + D)), onde D  a maior distncia.
 	 *
-	 * \note Complexidade: O((V + E) * log(V)), onde V  o nmero de ns (Citys) e E  o nmero de arestas.
+	 * \param threads Nmero de threads usadas na busca. O valor 0 usa todos os processadores.
+	 *                A capital escolhida  a mesma para qualquer nmero de threads.
 	 */
-	void calcCapital();
+	void calcCapital(std::size_t threads = 1);
 
 	/**
 	 * \brief Calcula os batalhes e o patrulhamento no grafo.
 	 *
 	 * Este mtodo executa uma sequncia de algoritmos:
-	 * 1. Kosaraju para encontrar componentes fortemente conectadas (SCCs).
-	 * 2. Para cada componente fortemente conectada (n componentes no total), executa:
+	 * 1. Pearce para encontrar componentes fortemente conectadas (SCCs), com a DFS comeando pela
+	 *    capital. A condensao de `calcCapital`  reaproveitada se a sua DFS comeou pela mesma cidade.
+	 * 2. Para cada componente fortemente conectada com mais de uma cidade, executa (`PatrolBuilder`):
 	 *    - Uma busca em profundidade (DFS) para analisar conexes internas.
-	 *    - O algoritmo de Dijkstra para calcular rotas e custos associados.
+	 *    - Uma busca em largura (BFS), ou um Dijkstra se as estradas tiverem pesos, para o caminho
+	 *      de volta at o batalho.
+	 *    Ambas seguem o sentido das estradas, restritas s cidades da componente, sem copi-la.
 	 *
 	 * \note Complexidade:
-	 * - Kosaraju: O(V + E), onde V  o nmero de ns e E  o nmero de arestas.
-	 * - DFS e Dijkstra sequenciais: O(n * (V + E) * log(V)), onde n  o nmero de componentes fortemente conectadas.
+	 * - Pearce: O(V + E), onde V  o nmero de ns e E  o nmero de arestas.
+	 * - DFS e BFS de todas as componentes: O(V + E), divididos entre as threads.
+	 *
+	 * \param threads Nmero de threads que constroem as patrulhas. O valor 0 usa todos os processadores.
+	 *                As patrulhas so sempre emitidas na ordem das componentes.
 	 */
-	void calcBattalionsAndPatrolling();
+	void calcBattalionsAndPatrolling(std::size_t threads = 1);
 
 	/**
 	 * \brief Obtm os ns do grafo.
@@ -69,19 +111,54 @@ public:
 	 * manipular ou acessar os ns do grafo.
 	 */
 	std::vector<City>& getNodes();
+	const std::vector<City>& getNodes() const;
+
+	/**
+	 * \brief Obtm o grafo CSR com as estradas entre as cidades.
+	 * \return Referncia ao grafo, indexado pela posio das cidades em `getNodes()`.
+	 */
+	const Graph& getGraph() const;
+
+	/**
+	 * \brief Substitui o grafo CSR, com as mesmas cidades.
+	 * \param graph O novo grafo, indexado pela posio das cidades em `getNodes()`.
+	 *
+	 * As componentes calculadas para o grafo anterior deixam de valer e so recalculadas no prximo uso.
+	 */
+	void setGraph(Graph graph);
+
+	/**
+	 * \brief Obtm o identificador de uma cidade no grafo.
+	 * \param city A cidade procurada, comparada pelo ndice.
+	 * \return A posio da cidade em `getNodes()`, ou `NO_CITY` se ela no pertencer ao grafo.
+	 */
+	CityId getId(const City& city) const;
+
+	/**
+	 * \brief Obtm a tabela com os nomes das cidades.
+	 * \return Referncia  tabela; o nome de uma cidade  `getNames().get(city.getNameId())`.
+	 */
+	const NameTable& getNames() const;
+
+	/**
+	 * \brief Obtm o nome de uma cidade.
+	 * \param node Identificador da cidade no grafo, ou `NO_CITY`.
+	 * \return O nome da cidade, ou um nome vazio para `NO_CITY`.
+	 */
+	std::string_view getName(CityId node) const;
 
 	/**
 	 * \brief Obtm a cidade capital do grafo.
-	 * \return A cidade definida como capital.
+	 * \return O identificador da capital, ou `NO_CITY` se no houver capital.
 	 *
 	 * Este mtodo retorna a cidade calculada como a capital do grafo, aps a
 	 * execuo de `calcCapital`.
 	 */
-	City getCapital() const;
+	CityId getCapital() const;
 
 	/**
 	 * \brief Obtm os batalhes definidos no grafo.
-	 * \return Um vetor de cidades representando os batalhes.
+	 * \return Os identificadores das cidades dos batalhes, sem cpia.
 	 *
 	 * Este mtodo retorna a lista de cidades que foram classificadas como batalhes
 	 * aps a execuo de `calcBattalionsAndPatrolling`.
@@ -89,13 +166,50 @@ public:
 	Battalions getBattalions() const;
 
 	/**
-	 * \brief Obtm as patrulhas definidas no grafo.
-	 * \return Um vetor de vetores de cidades representando as rotas de patrulha.
+	 * \brief Obtm as componentes fortemente conectadas de `getCondensation`.
 	 *
-	 * Este mtodo retorna as rotas de patrulhamento definidas no grafo, calculadas
-	 * aps a execuo de `calcBattalionsAndPatrolling`.
+	 * Depois de `calcBattalionsAndPatrolling`, a DFS comea pela capital, ento a raiz de cada
+	 * componente  o seu batalho (ou a capital).
+	 */
+	const Components& getComponents() const;
+
+	/**
+	 * \brief Obtm o DAG das componentes fortemente conectadas, calculado por `calcCapital` ou por
+	 *        `calcBattalionsAndPatrolling`, ou uma condensao vazia antes deles.
+	 */
+	const Condensation& getCondensation() const;
+
+	/**
+	 * \brief Obtm a cidade onde comeou a DFS de `getCondensation`, ou `NO_CITY` se ela no foi calculada.
+	 *
+	 * A DFS visita essa cidade e depois as demais em ordem crescente de identificador; a raiz de cada
+	 * componente  a primeira cidade dela visitada.
 	 */
-	std::vector<Patrolling> getPatrolling() const;
+	CityId getCondensationStart() const;
+
+	/**
+	 * \brief Obtm o nmero de patrulhas definidas no grafo.
+	 */
+	std::size_t getPatrolCount() const;
+
+	/**
+	 * \brief Obtm a rota de uma patrulha.
+	 * \param patrol ndice da patrulha, de 0 a `getPatrolCount() - 1`.
+	 * \return Os identificadores das cidades da rota, sem cpia.
+	 */
+	Patrolling getPatrolling(std::size_t patrol) const;
+
+	/**
+	 * \brief Obtm as rotas de todas as patrulhas, concatenadas.
+	 *
+	 * A patrulha `i` ocupa as posies `getPatrolOffsets()[i]` a `getPatrolOffsets()[i + 1] - 1`.
+	 */
+	std::span<const CityId> getPatrolCities() const;
+
+	/**
+	 * \brief Obtm o incio de cada patrulha em `getPatrolCities()`; possui `getPatrolCount() + 1` posies.
+	 */
+	std::span<const std::size_t> getPatrolOffsets() const;
 
 	/**
 	 * \brief Verifica se h batalhes definidos no grafo.
@@ -116,12 +230,32 @@ private:
 	std::vector<City> m_nodes;
 
 	/**
-	 * \brief Cidade definida como capital do grafo.
+	 * \brief Estradas entre as cidades, no formato CSR.
 	 *
-	 * Aps a execuo de `calcCapital`, este atributo armazena o n que foi
-	 * determinado como capital.
+	 * O identificador de cada cidade no grafo  a sua posio em `m_nodes`.
+	 */
+	Graph m_graph;
+
+	/**
+	 * \brief Nomes das cidades, indexados por `City::getNameId`.
+	 */
+	NameTable m_names;
+
+	/**
+	 * \brief Identificador da capital no grafo, ou `NO_CITY` se no houver capital.
+	 */
+	CityId m_capitalId = NO_CITY;
+
+	/**
+	 * \brief Calcula `m_condensation` com a DFS comeando por `start`, se ela ainda no comeou por essa cidade.
+	 */
+	void condense(CityId start);
+
+	/**
+	 * \brief Componentes fortemente conectadas, em ordem topolgica, e o DAG entre elas.
 	 */
-	City m_capital;
+	Condensation m_condensation;
+	CityId m_condensationStart = NO_CITY;
 
 	/**
 	 * \brief Lista de cidades classificadas como batalhes.
@@ -129,15 +263,20 @@ private:
 	 * Aps a execuo de `calcBattalionsAndPatrolling`, este vetor armazena os
 	 * batalhes definidos no grafo.
 	 */
-	Battalions m_battalions;
+	std::vector<CityId> m_battalions;
 
 	/**
-	 * \brief Lista de rotas de patrulhamento.
+	 * \brief Rotas de patrulhamento, concatenadas.
 	 *
-	 * Aps a execuo de `calcBattalionsAndPatrolling`, este vetor de vetores armazena
-	 * as rotas de patrulha definidas no grafo.
+	 * Aps a execuo de `calcBattalionsAndPatrolling`, este vetor armazena as cidades
+	 * de todas as rotas de patrulha, uma rota aps a outra.
+	 */
+	std::vector<CityId> m_patrolCities;
+
+	/**
+	 * \brief Incio de cada rota em `m_patrolCities`.
 	 */
-	std::vector<Patrolling> m_patrolling;
+	std::vector<std::size_t> m_patrolOffsets = { 0 };
 
 	/**
 	 * \brief Indica se batalhes foram definidos no grafo.
@@ -0,0 +1,90 @@
+#ifndef BucketQueue_H
+#define BucketQueue_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Graph.h"
+#include "IndexedHeap.h"
+
+/**
+ * \class BucketQueue
+ * \brief Fila de prioridade monotnica para o Dijkstra com pesos inteiros pequenos (Dial).
+ *
+ * Em uma busca com pesos entre 1 e C, toda cidade na fila est a uma distncia entre a
+ * menor distncia atual e essa distncia mais C. A fila guarda um balde por distncia em
+ * um vetor circular de C + 1 baldes: inserir custa O(1) e retirar anda, no mximo, C
+ * baldes vazios, ento uma busca inteira custa O(V + E + D), onde D  a maior distncia,
+ * prximo do custo de uma BFS.
+ *
+ * Acima de `MAX_BUCKETS`, os baldes gastariam memria demais e a fila passa a ser um
+ * `IndexedHeap`, em que inserir uma cidade que ainda est na fila s diminui a sua distncia.
+ * Nos baldes, as inseres repetidas de uma cidade no so removidas: quem retira deve
+ * ignorar as cidades cuja distncia j foi melhorada (remoo preguiosa).
+ */
+class BucketQueue {
+public:
+	/**
+	 * \brief Maior peso de estrada atendido pelos baldes.
+	 */
+	static constexpr Weight MAX_BUCKETS = 1 << 12;
+
+	/**
+	 * \brief Cria uma fila vazia.
+	 * \param maxWeight O maior peso das estradas da busca (`Graph::maxWeight`).
+	 * \param size Nmero de cidades da busca, para reservar o ndice do heap.
+	 */
+	explicit BucketQueue(Weight maxWeight, std::size_t size = 0);
+
+	/**
+	 * \brief Indica se a fila usa os baldes, e no o heap.
+	 */
+	bool usesBuckets() const { return !m_buckets.empty(); }
+
+	/**
+	 * \brief Verifica se a fila est vazia.
+	 */
+	bool empty() const { return usesBuckets() ? m_size == 0 : m_heap.empty(); }
+
+	/**
+	 * \brief Insere uma cidade. No heap, uma cidade que j est na fila tem a sua distncia diminuda.
+	 *
+	 * \param node A cidade.
+	 * \param distance A sua distncia, entre a ltima distncia retirada e ela mais o maior peso.
+	 *
+	 * \note Complexidade: O(1) com baldes, O(log V) com o heap.
+	 */
+	void push(CityId node, Distance distance);
+
+	/**
+	 * \brief Retira uma cidade de menor distncia.
+	 *
+	 * \param distance Recebe a distncia com que a cidade foi inserida.
+	 * \return A cidade. A fila no pode estar vazia.
+	 */
+	CityId pop(Distance& distance);
+
+	/**
+	 * \brief Esvazia a fila para uma nova busca, mantendo a memria alocada.
+	 */
+	void clear();
+
+private:
+	/**
+	 * \brief Baldes indexados pela distncia mdulo o seu nmero.
+	 */
+	std::vector<std::vector<CityId>> m_buckets;
+
+	/**
+	 * \brief Distncia do balde atual; nenhuma cidade na fila tem distncia menor.
+	 */
+	Distance m_current = 0;
+	std::size_t m_size = 0;
+
+	/**
+	 * \brief Heap usado quando os pesos so grandes.
+	 */
+	IndexedHeap m_heap;
+};
+
+#endif // BucketQueue_H
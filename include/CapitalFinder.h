@@ -0,0 +1,213 @@
+#ifndef CapitalFinder_H
+#define CapitalFinder_H
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Condensation.h"
+#include "Graph.h"
+#include "SearchWorkspace.h"
+
+/**
+ * \class CapitalFinder
+ * \brief Motor de escolha da capital baseado em buscas em largura (BFS).
+ *
+ * Quando todas as estradas tm peso 1, a distncia de uma cidade a outra  o nmero de
+ * estradas do caminho mais curto, e uma BFS encontra todas essas distncias. A soma das
+ * distncias e o nmero de cidades alcanadas so acumulados durante a prpria busca,
+ * sem construir nenhum caminho.
+ *
+ * Com estradas de pesos diferentes, a BFS d lugar a um Dijkstra com a fila de baldes
+ * (`BucketQueue`), que tambm soma as distncias  medida que as cidades so fixadas.
+ *
+ * A capital  a cidade que alcana todas as outras com a menor soma positiva de
+ * distncias. Em caso de empate, a cidade de menor identificador  escolhida.
+ *
+ * A fila e o conjunto de visitados so vetores planos reaproveitados entre as buscas.
+ *
+ * H duas estratgias para calcular as somas de todas as cidades, que escolhem sempre
+ * a mesma capital:
+ * - `Strategy::PER_SOURCE`: uma BFS por cidade, interrompida assim que a cidade deixa
+ *   de poder ser a capital.
+ * - `Strategy::BIT_PARALLEL`: BFSs de 64 cidades de uma vez. Cada cidade guarda, em uma
+ *   palavra de 64 bits, quais das origens do lote j a visitaram e quais a alcanaram no
+ *   ltimo nvel, de modo que uma nica passada pelas estradas avana as 64 buscas. Os
+ *   nveis s correspondem s distncias sem pesos; em um grafo com pesos, `find` usa
+ *   `Strategy::PER_SOURCE`.
+ *
+ * Antes das buscas, os candidatos so podados pelas componentes fortemente conectadas:
+ * uma cidade que alcana todas as outras s pode estar na nica componente sem estradas
+ * vindas de outras componentes (a fonte do DAG de componentes). Se houver mais de uma
+ * componente fonte, nenhuma cidade  a capital e nenhuma busca  feita.
+ */
+class CapitalFinder {
+public:
+	/**
+	 * \brief Estratgia usada por `find` para calcular as somas de distncias.
+	 */
+	enum class Strategy {
+		// Uma BFS por cidade.
+		PER_SOURCE,
+		// Lotes de 64 BFSs simultneas.
+		BIT_PARALLEL
+	};
+
+	/**
+	 * \brief Valor retornado por `distanceSum` quando a cidade no pode ser a capital.
+	 */
+	static constexpr Distance REJECTED = std::numeric_limits<Distance>::max();
+
+	/**
+	 * \brief Cria o motor para um grafo.
+	 * \param graph O grafo percorrido. Deve permanecer vlido enquanto o motor for usado.
+	 */
+	explicit CapitalFinder(const Graph& graph);
+
+	/**
+	 * \brief Calcula a soma das distncias de uma cidade a todas as outras.
+	 *
+	 * \param source A cidade de origem da busca.
+	 * \param bound A busca  interrompida assim que a soma parcial atinge esse valor,
+	 *              pois a cidade j no pode ter soma menor.
+	 *
+	 * \return A soma das distncias, ou `REJECTED` se a cidade no alcana todas as
+	 *         outras ou se a soma atingiu `bound`.
+	 *
+	 * \note Complexidade: O(V + E) de tempo, sem alocar memria. Com pesos, O(V + E + D) com
+	 *       os baldes, onde D  a maior distncia, ou O((V + E) * log(V)) com pesos grandes.
+	 */
+	Distance distanceSum(CityId source, Distance bound = REJECTED);
+
+	/**
+	 * \brief Calcula as somas das distncias de um lote de at 64 cidades com BFSs simultneas.
+	 *
+	 * O grafo no pode ter pesos.
+	 *
+	 * \param sources As cidades de origem do lote, no mximo 64.
+	 * \param sums Recebe a soma das distncias de cada origem, na mesma ordem de `sources`,
+	 *             ou `REJECTED` se a origem no alcana todas as outras cidades.
+	 *
+	 * \note Complexidade: O(D * (V + E)), onde D  a maior distncia a partir de uma origem do lote.
+	 */
+	void distanceSums(std::span<const CityId> sources, std::span<Distance> sums);
+
+	/**
+	 * \brief Obtm as cidades que podem ser a capital.
+	 *
+	 * \return As cidades da nica componente fonte, em ordem crescente, ou um vetor vazio se
+	 *         houver mais de uma componente fonte.
+	 *
+	 * \note Complexidade: O(V + E), com o algoritmo de Pearce.
+	 */
+	std::vector<CityId> candidates() const;
+
+	/**
+	 * \brief Obtm as cidades que podem ser a capital a partir de uma condensao j calculada.
+	 *
+	 * \param condensation O DAG das componentes do grafo.
+	 * \return As cidades da nica componente fonte, em ordem crescente, ou um vetor vazio se
+	 *         houver mais de uma componente fonte.
+	 *
+	 * \note Complexidade: O(n * log(n)), onde n  o nmero de cidades da componente fonte.
+	 */
+	static std::vector<CityId> candidates(const Condensation& condensation);
+
+	/**
+	 * \brief Encontra a capital do grafo entre as cidades de `candidates()`.
+	 *
+	 * \param strategy Estratgia usada para calcular as somas de distncias.
+	 * \param threads Nmero de threads usadas na busca. O valor 0 usa todos os processadores.
+	 * \return O identificador da capital, ou `NO_CITY` se nenhuma cidade alcana todas as outras.
+	 *
+	 * \note Complexidade: O(V + E) para as componentes, mais a busca restrita aos candidatos.
+	 */
+	CityId find(Strategy strategy = Strategy::PER_SOURCE, std::size_t threads = 1);
+
+	/**
+	 * \brief Encontra a capital entre um conjunto de cidades.
+	 *
+	 * As origens so divididas em lotes de `BATCH_SIZE` cidades, distribudos entre as threads.
+	 * Cada thread usa a sua prpria rea de trabalho, e os melhores candidatos de cada lote so
+	 * reduzidos na ordem dos lotes, ento a capital escolhida no depende do nmero de threads.
+	 *
+	 * \param candidates As cidades candidatas, em ordem crescente. O empate fica com a primeira.
+	 * \param strategy Estratgia usada para calcular as somas de distncias.
+	 * \param threads Nmero de threads usadas na busca. O valor 0 usa todos os processadores.
+	 * \return O identificador da capital, ou `NO_CITY` se nenhum candidato alcana todas as outras cidades.
+	 *
+	 * \note Complexidade: O(C * (V + E)) com `Strategy::PER_SOURCE` e O(C / 64 * D * (V + E))
+	 *       com `Strategy::BIT_PARALLEL`, onde C  o nmero de candidatos e D  o dimetro do grafo,
+	 *       divididos entre as threads.
+	 */
+	CityId find(std::span<const CityId> candidates, Strategy strategy, std::size_t threads = 1);
+
+	/**
+	 * \brief Nmero de origens de um lote de `distanceSums`, uma por bit da palavra, e de cada tarefa de `find`.
+	 */
+	static constexpr std::size_t BATCH_SIZE = 64;
+
+private:
+	/**
+	 * \brief `distanceSum` em um grafo com pesos.
+	 */
+	Distance weightedDistanceSum(CityId source, Distance bound);
+
+	/**
+	 * \brief Verifica se uma cidade j foi visitada pela busca atual.
+	 */
+	bool visited(CityId node) const { return (m_visited[node >> 6] >> (node & 63u)) & 1u; }
+
+	/**
+	 * \brief Marca uma cidade como visitada pela busca atual.
+	 */
+	void visit(CityId node) { m_visited[node >> 6] |= std::uint64_t{ 1 } << (node & 63u); }
+
+	/**
+	 * \brief O grafo percorrido.
+	 */
+	const Graph& m_graph;
+
+	/**
+	 * \brief Cidades visitadas pela busca atual, 1 bit por cidade.
+	 */
+	std::vector<std::uint64_t> m_visited;
+
+	/**
+	 * \brief Fila da BFS. Ao final da busca, contm exatamente as cidades visitadas.
+	 */
+	std::vector<CityId> m_queue;
+
+	/**
+	 * \brief Lotes: origens que j visitaram cada cidade, 1 bit por origem.
+	 */
+	std::vector<std::uint64_t> m_seen;
+
+	/**
+	 * \brief Lotes: origens que alcanaram cada cidade no ltimo nvel.
+	 */
+	std::vector<std::uint64_t> m_frontier;
+
+	/**
+	 * \brief Lotes: origens que alcanam cada cidade no prximo nvel.
+	 */
+	std::vector<std::uint64_t> m_next;
+
+	/**
+	 * \brief Lotes: cidades com fronteira no vazia no nvel atual.
+	 */
+	std::vector<CityId> m_active;
+
+	/**
+	 * \brief Lotes: cidades alcanadas a partir do nvel atual.
+	 */
+	std::vector<CityId> m_touched;
+
+	/**
+	 * \brief Pesos: distncias e fila do Dijkstra, reaproveitadas entre as origens.
+	 */
+	SearchWorkspace m_workspace;
+};
+
+#endif // CapitalFinder_H
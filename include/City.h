@@ -2,9 +2,9 @@
 #define City_H
 
 #include <vector>
-#include <string>
 #include <unordered_map>
 
+#include "NameTable.h"
 #include "Road.h"
 
 class Road;
@@ -72,11 +72,11 @@ public:
 	 * \brief Construtor de City com ndice e nome.
 	 *
 	 * \param index ndice nico para identificar a cidade.
-	 * \param name Nome opcional para a cidade.
+	 * \param name Identificador opcional do nome da cidade em uma `NameTable`.
 	 *
 	 * Este construtor inicializa um n com um ndice especfico e, opcionalmente, um nome.
 	 */
-	City(std::size_t index, std::string name = "");
+	City(std::size_t index, NameId name = NO_NAME);
 
 	/**
 	 * \brief Obtm o ndice da cidade.
@@ -88,10 +88,11 @@ public:
 	 * \brief Conecta dois ns (Citys).
 	 *
 	 * \param node Ponteiro para o n a ser conectado a este.
+	 * \param weight Tempo de viagem da conexo.
 	 *
 	 * Adiciona uma conexo (Road) entre este n e o n fornecido.
 	 */
-	void connect(City* node);
+	void connect(City* node, int weight = 1);
 
 	/**
 	 * \brief Verifica se este n est conectado a outro n.
@@ -102,10 +103,12 @@ public:
 	bool isConnected(City* node);
 
 	/**
-	 * \brief Obtm o nome da cidade.
-	 * \return Referncia para o nome da cidade.
+	 * \brief Obtm o identificador do nome da cidade.
+	 * \return O identificador do nome na `NameTable` do mapa, ou `NO_NAME` se a cidade no tiver nome.
+	 *
+	 * O texto do nome  obtido com `NameTable::get` (por exemplo, `Archadian::getNames`).
 	 */
-	std::string& getName();
+	NameId getNameId() const;
 
 	/**
 	 * \brief Obtm as arestas conectadas ao n.
@@ -116,6 +119,12 @@ public:
 	 */
 	std::vector<Road>& getEdges();
 
+	/**
+	 * \brief Obtm as arestas conectadas ao n, sem permitir alteraes.
+	 * \return Referncia constante para o vetor de Roads que partem deste n.
+	 */
+	const std::vector<Road>& getEdges() const;
+
 	/**
 	 * \brief Define as arestas conectadas ao n.
 	 *
@@ -198,11 +207,12 @@ private:
 	std::size_t m_index;
 
 	/**
-	 * \brief Nome da cidade.
+	 * \brief Identificador do nome da cidade.
 	 *
-	 * Nome opcional que pode ser usado para identificar o n de forma descritiva.
+	 * Nome opcional que pode ser usado para identificar o n de forma descritiva. O texto
+	 * fica na `NameTable` do mapa, e copiar uma cidade nunca copia o seu nome.
 	 */
-	std::string m_name;
+	NameId m_name = NO_NAME;
 };
 
 namespace std {
@@ -0,0 +1,90 @@
+#ifndef Components_H
+#define Components_H
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Graph.h"
+
+/**
+ * \brief Identificador denso de uma componente fortemente conectada.
+ */
+using ComponentId = std::uint32_t;
+
+/**
+ * \brief Valor reservado para indicar a ausncia de uma componente.
+ */
+constexpr ComponentId NO_COMPONENT = std::numeric_limits<ComponentId>::max();
+
+/**
+ * \class Components
+ * \brief Componentes fortemente conectadas (SCCs) de um grafo.
+ *
+ * Guarda a componente de cada cidade e, no formato CSR, a lista de cidades de cada
+ * componente. As componentes esto em ordem topolgica: nenhuma estrada vai de uma
+ * componente para outra anterior. A primeira cidade de cada componente  a sua raiz,
+ * a primeira cidade da componente descoberta pela DFS.
+ */
+class Components {
+public:
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria um conjunto vazio de componentes.
+	 */
+	Components();
+
+	/**
+	 * \brief Constri as componentes a partir dos vetores j calculados.
+	 *
+	 * \param component Componente de cada cidade, indexada pelo identificador da cidade.
+	 * \param offsets Incio das cidades de cada componente em `members`; possui C + 1 posies.
+	 * \param members Cidades agrupadas por componente, com a raiz primeiro.
+	 */
+	Components(std::vector<ComponentId> component, std::vector<CityId> offsets, std::vector<CityId> members);
+
+	/**
+	 * \brief Obtm o nmero de componentes.
+	 */
+	std::size_t count() const;
+
+	/**
+	 * \brief Obtm a componente de uma cidade.
+	 */
+	ComponentId componentOf(CityId node) const { return m_component[node]; }
+
+	/**
+	 * \brief Obtm as cidades de uma componente, com a raiz primeiro.
+	 */
+	std::span<const CityId> members(ComponentId component) const;
+
+	/**
+	 * \brief Obtm o nmero de cidades de uma componente.
+	 */
+	std::size_t size(ComponentId component) const { return m_offsets[component + 1] - m_offsets[component]; }
+
+	/**
+	 * \brief Obtm a raiz de uma componente.
+	 */
+	CityId root(ComponentId component) const { return m_members[m_offsets[component]]; }
+
+private:
+	/**
+	 * \brief Componente de cada cidade.
+	 */
+	std::vector<ComponentId> m_component;
+
+	/**
+	 * \brief Incio das cidades de cada componente em `m_members`.
+	 */
+	std::vector<CityId> m_offsets;
+
+	/**
+	 * \brief Cidades agrupadas por componente.
+	 */
+	std::vector<CityId> m_members;
+};
+
+#endif // Components_H
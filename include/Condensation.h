@@ -0,0 +1,104 @@
+#ifndef Condensation_H
+#define Condensation_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Components.h"
+#include "Graph.h"
+
+/**
+ * \class Condensation
+ * \brief O DAG das componentes fortemente conectadas de um grafo.
+ *
+ * Guarda as componentes (`Components`) e, no formato CSR, as arestas entre componentes
+ * diferentes, sem repeties: h uma aresta de A para B se alguma estrada vai de uma cidade
+ * de A para uma cidade de B. Os identificadores das componentes j so uma ordem topolgica,
+ * ento toda aresta vai para uma componente de identificador maior, e as arestas de cada
+ * componente ficam em ordem crescente.
+ *
+ * A escolha dos candidatos a capital, os batalhes e as patrulhas consomem a mesma
+ * condensao, calculada uma nica vez pelo `Archadian`.
+ */
+class Condensation {
+public:
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria uma condensao vazia, sem componentes.
+	 */
+	Condensation();
+
+	/**
+	 * \brief Constri o DAG das componentes de um grafo.
+	 *
+	 * \param graph O grafo original.
+	 * \param components As componentes fortemente conectadas de `graph` (`Algorithms::Pearce`).
+	 *
+	 * \note Complexidade: O(V + E + A * log(A)), onde A  o nmero de arestas do DAG.
+	 */
+	Condensation(const Graph& graph, Components components);
+
+	/**
+	 * \brief Obtm as componentes, com a cidade de cada uma e as suas razes.
+	 */
+	const Components& components() const { return m_components; }
+
+	/**
+	 * \brief Obtm o nmero de componentes.
+	 */
+	std::size_t count() const { return m_components.count(); }
+
+	/**
+	 * \brief Obtm a componente de uma cidade.
+	 */
+	ComponentId componentOf(CityId node) const { return m_components.componentOf(node); }
+
+	/**
+	 * \brief Obtm o nmero de cidades de uma componente.
+	 */
+	std::size_t size(ComponentId component) const { return m_components.size(component); }
+
+	/**
+	 * \brief Obtm as componentes alcanadas por uma estrada que sai de uma componente, em ordem crescente.
+	 */
+	std::span<const ComponentId> successors(ComponentId component) const {
+		return std::span<const ComponentId>(m_targets.data() + m_offsets[component], m_offsets[component + 1] - m_offsets[component]);
+	}
+
+	/**
+	 * \brief Obtm o nmero de componentes com alguma estrada para uma componente.
+	 */
+	std::size_t inDegree(ComponentId component) const { return m_inDegree[component]; }
+
+	/**
+	 * \brief Obtm o nmero de arestas do DAG.
+	 */
+	std::size_t edgeCount() const { return m_targets.size(); }
+
+	/**
+	 * \brief Obtm o nmero de componentes fonte, sem arestas de entrada no DAG.
+	 *
+	 * Em ordem topolgica, a componente 0  sempre uma fonte.
+	 */
+	std::size_t sourceCount() const { return m_sourceCount; }
+
+private:
+	Components m_components;
+
+	/**
+	 * \brief Incio das arestas de cada componente em `m_targets`; possui C + 1 posies.
+	 */
+	std::vector<EdgeIndex> m_offsets;
+
+	/**
+	 * \brief Destino de cada aresta do DAG, agrupadas por origem.
+	 */
+	std::vector<ComponentId> m_targets;
+
+	std::vector<std::uint32_t> m_inDegree;
+	std::size_t m_sourceCount = 0;
+};
+
+#endif // Condensation_H
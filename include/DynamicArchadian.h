@@ -0,0 +1,302 @@
+#ifndef DynamicArchadian_H
+#define DynamicArchadian_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Archadian.h"
+#include "Components.h"
+#include "Graph.h"
+#include "NameTable.h"
+
+/**
+ * \class DynamicArchadian
+ * \brief Modo incremental do `Archadian`: mantm as componentes, os batalhes e as
+ *        patrulhas enquanto estradas so abertas e fechadas.
+ *
+ * As estradas ficam em listas de adjacncia mutveis (de sada e de entrada), e as
+ * componentes fortemente conectadas so mantidas em uma ordem topolgica dinmica
+ * (Pearce e Kelly), sem recalcular o grafo inteiro:
+ * - Abrir uma estrada que respeita a ordem no muda nada. Caso contrrio, apenas as
+ *   componentes cujas posies esto entre as das duas pontas so visitadas: as que
+ *   esto em um ciclo com a nova estrada so unidas e as demais so reordenadas.
+ * - Fechar uma estrada entre componentes diferentes no muda nada. Dentro de uma
+ *   componente, o algoritmo de Pearce  executado s nas cidades dela, que podem se
+ *   separar em vrias componentes consecutivas na ordem.
+ *
+ * Cada componente tem um representante estvel, onde fica o seu batalho: inicialmente
+ * a raiz calculada pelo `Archadian` (a capital na componente da capital). Uma unio
+ * fica com o representante da componente que vinha primeiro na ordem; em uma separao,
+ * a parte que contm o representante fica com ele e cada outra parte  representada
+ * pela sua cidade de menor identificador. Depois das mudanas, a capital pode estar em
+ * uma componente representada por outra cidade: essa componente no tem batalho, e a
+ * sua patrulha comea pela capital.
+ *
+ * A patrulha de uma componente s  reconstruda (`PatrolBuilder`, a partir do
+ * representante) quando  consultada aps uma mudana nas suas estradas internas. A
+ * capital depende de distncias no grafo inteiro e  recalculada quando consultada aps
+ * qualquer mudana.
+ */
+class DynamicArchadian {
+public:
+	/**
+	 * \brief Inicia o modo incremental a partir de um mapa carregado.
+	 *
+	 * \param archadian O mapa, com a capital j calculada se ela for conhecida. As
+	 *                  componentes iniciais so as mesmas de `calcBattalionsAndPatrolling`.
+	 * \param threads Nmero de threads usadas para recalcular a capital.
+	 *
+	 * \note Complexidade: O(V + E).
+	 */
+	explicit DynamicArchadian(const Archadian& archadian, std::size_t threads = 1);
+
+	/**
+	 * \brief Obtm o nmero de cidades.
+	 */
+	std::size_t size() const { return m_out.size(); }
+
+	/**
+	 * \brief Obtm o nome de uma cidade, ou um nome vazio para `NO_CITY`.
+	 */
+	std::string_view getName(CityId city) const;
+
+	/**
+	 * \brief Procura uma cidade pelo nome.
+	 * \return O identificador da cidade, ou `NO_CITY` se no houver cidade com esse nome.
+	 */
+	CityId findCity(std::string_view name);
+
+	/**
+	 * \brief Acrescenta uma cidade sem estradas, em uma componente prpria.
+	 * \return O identificador da nova cidade, igual ao nmero de cidades anteriores.
+	 */
+	CityId addCity(std::string_view name);
+
+	/**
+	 * \brief Abre uma estrada.
+	 *
+	 * \param weight O peso da estrada, positivo.
+	 *
+	 * \note Complexidade: O(1) se a estrada respeitar a ordem das componentes; caso
+	 *       contrrio, proporcional s estradas das componentes entre as duas pontas.
+	 */
+	void addRoad(CityId source, CityId target, Weight weight = 1);
+
+	/**
+	 * \brief Fecha uma estrada. Se houver estradas repetidas, apenas uma  fechada.
+	 *
+	 * \return Falso se a estrada no existir.
+	 *
+	 * \note Complexidade: O(grau) entre componentes diferentes; O(n + m) dentro de uma
+	 *       componente com n cidades e m estradas internas.
+	 */
+	bool removeRoad(CityId source, CityId target);
+
+	/**
+	 * \brief Obtm os destinos das estradas que saem de uma cidade, com repeties.
+	 */
+	std::span<const CityId> neighbors(CityId city) const { return m_out[city]; }
+
+	/**
+	 * \brief Obtm os pesos das estradas de `neighbors(city)`, na mesma ordem.
+	 */
+	std::span<const Weight> weights(CityId city) const { return m_weights[city]; }
+
+	/**
+	 * \brief Obtm as origens das estradas que chegam em uma cidade, com repeties.
+	 */
+	std::span<const CityId> predecessors(CityId city) const { return m_in[city]; }
+
+	/**
+	 * \brief Obtm os pesos das estradas de `predecessors(city)`, na mesma ordem.
+	 */
+	std::span<const Weight> predecessorWeights(CityId city) const { return m_inWeights[city]; }
+
+	/**
+	 * \brief Verifica se alguma estrada aberta tem peso diferente de 1.
+	 */
+	bool isWeighted() const { return m_weightedRoads != 0; }
+
+	/**
+	 * \brief Obtm o maior peso de estrada j aberto, um limite para os pesos atuais.
+	 */
+	Weight maxWeight() const { return m_maxWeight; }
+
+	/**
+	 * \brief Verifica, pela ordem das componentes, se `source` ainda pode alcanar `target`.
+	 *
+	 * Falso garante que no h caminho; verdadeiro  garantido apenas para cidades da mesma componente.
+	 *
+	 * \note Complexidade: O(1).
+	 */
+	bool mayReach(CityId source, CityId target) const {
+		return m_components[m_component[source]].position <= m_components[m_component[target]].position;
+	}
+
+	/**
+	 * \brief Obtm o nmero de componentes fortemente conectadas.
+	 */
+	std::size_t componentCount() const { return m_componentCount; }
+
+	/**
+	 * \brief Obtm a componente de uma cidade.
+	 *
+	 * Os identificadores das componentes no so densos: os de componentes unidas so
+	 * reaproveitados por separaes posteriores.
+	 */
+	ComponentId componentOf(CityId city) const { return m_component[city]; }
+
+	/**
+	 * \brief Obtm as componentes em ordem topolgica.
+	 * \note Complexidade: O(C), onde C  o nmero de componentes.
+	 */
+	std::vector<ComponentId> getComponents() const;
+
+	/**
+	 * \brief Obtm as cidades de uma componente, em nenhuma ordem especfica.
+	 */
+	std::span<const CityId> getMembers(ComponentId component) const { return m_components[component].members; }
+
+	/**
+	 * \brief Obtm o representante de uma componente, onde fica o seu batalho.
+	 */
+	CityId getRepresentative(ComponentId component) const { return m_components[component].representative; }
+
+	/**
+	 * \brief Obtm a capital, recalculando-a se o mapa mudou desde a ltima consulta.
+	 * \return O identificador da capital, ou `NO_CITY` se no houver capital.
+	 */
+	CityId getCapital();
+
+	/**
+	 * \brief Obtm os representantes das componentes, em ordem topolgica, exceto o da componente da capital.
+	 */
+	std::vector<CityId> getBattalions();
+
+	/**
+	 * \brief Obtm a patrulha de uma componente, reconstruindo-a se as suas estradas ou a capital mudaram.
+	 *
+	 * A patrulha comea pela capital na componente da capital e pelo representante nas demais.
+	 *
+	 * \return As cidades da rota, vazia para uma componente de uma cidade s. Vlida at a prxima mudana.
+	 */
+	Patrolling getPatrolling(ComponentId component);
+
+private:
+	/**
+	 * \brief Estado de uma componente.
+	 */
+	struct Component {
+		std::vector<CityId> members;
+		CityId representative = NO_CITY;
+
+		/**
+		 * \brief Posio da componente em `m_order`.
+		 */
+		std::size_t position = 0;
+
+		/**
+		 * \brief Patrulha calculada e a cidade onde ela comea: a capital, se estiver na componente,
+		 *        ou o representante.
+		 */
+		std::vector<CityId> patrol;
+		CityId patrolStart = NO_CITY;
+		bool patrolValid = false;
+	};
+
+	/**
+	 * \brief Cria uma componente vazia, reaproveitando um identificador livre.
+	 */
+	ComponentId allocate();
+
+	/**
+	 * \brief Coleta em `found` as componentes alcanveis a partir de `start` (ou que
+	 *        alcanam `start`, se `forward` for falso) sem sair da faixa de posies `[lower, upper]`.
+	 */
+	void search(ComponentId start, std::size_t lower, std::size_t upper, bool forward,
+		std::vector<std::uint32_t>& mark, std::vector<ComponentId>& found);
+
+	/**
+	 * \brief Une as componentes em uma s.
+	 * \return A componente que contm todas as cidades.
+	 */
+	ComponentId merge(const std::vector<ComponentId>& components);
+
+	/**
+	 * \brief Separa uma componente que pode ter deixado de ser fortemente conectada.
+	 */
+	void split(ComponentId component);
+
+	/**
+	 * \brief Reconstri `m_order` sem posies vazias, substituindo `replaced` por `parts`.
+	 */
+	void renumber(ComponentId replaced, const std::vector<ComponentId>& parts);
+
+	/**
+	 * \brief Constri o subgrafo induzido por uma componente, com as cidades renumeradas.
+	 *
+	 * \param members Recebe as cidades da componente em ordem crescente; a cidade
+	 *                `members[i]`  a cidade `i` do subgrafo.
+	 */
+	Graph induced(ComponentId component, std::vector<CityId>& members);
+
+	/**
+	 * \brief Estradas que saem e que chegam em cada cidade, com repeties.
+	 */
+	std::vector<std::vector<CityId>> m_out;
+	std::vector<std::vector<CityId>> m_in;
+
+	/**
+	 * \brief Peso de cada estrada de `m_out` e de `m_in` e nmero de estradas com peso diferente de 1.
+	 */
+	std::vector<std::vector<Weight>> m_weights;
+	std::vector<std::vector<Weight>> m_inWeights;
+	std::size_t m_weightedRoads = 0;
+	Weight m_maxWeight = 1;
+
+	NameTable m_names;
+	std::vector<NameId> m_cityName;
+
+	/**
+	 * \brief Cidade de cada nome, ou `NO_CITY`.
+	 */
+	std::vector<CityId> m_nameCity;
+
+	/**
+	 * \brief Componente de cada cidade.
+	 */
+	std::vector<ComponentId> m_component;
+
+	/**
+	 * \brief Componentes, indexadas pelo identificador; as livres ficam em `m_free`.
+	 */
+	std::vector<Component> m_components;
+	std::vector<ComponentId> m_free;
+	std::size_t m_componentCount = 0;
+
+	/**
+	 * \brief Componentes em ordem topolgica, com `NO_COMPONENT` nas posies vazias deixadas por unies.
+	 */
+	std::vector<ComponentId> m_order;
+
+	CityId m_capital = NO_CITY;
+	bool m_capitalValid = false;
+	std::size_t m_threads;
+
+	/**
+	 * \brief Marcas das buscas para frente e para trs, vlidas se iguais a `m_search`.
+	 */
+	std::vector<std::uint32_t> m_forward;
+	std::vector<std::uint32_t> m_backward;
+	std::uint32_t m_search = 0;
+	std::vector<ComponentId> m_stack;
+
+	/**
+	 * \brief Posio de cada cidade no subgrafo de `induced`.
+	 */
+	std::vector<CityId> m_local;
+};
+
+#endif // DynamicArchadian_H
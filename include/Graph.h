@@ -0,0 +1,176 @@
+#ifndef Graph_H
+#define Graph_H
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+class City;
+
+/**
+ * \brief Identificador denso de uma cidade dentro de um `Graph` (0..V-1).
+ */
+using CityId = std::uint32_t;
+
+/**
+ * \brief Posio de uma aresta no vetor de destinos do `Graph`.
+ */
+using EdgeIndex = std::uint32_t;
+
+/**
+ * \brief Peso de uma estrada.
+ */
+using Weight = std::uint32_t;
+
+/**
+ * \brief Distncia acumulada de um caminho.
+ */
+using Distance = std::uint64_t;
+
+/**
+ * \brief Valor reservado para indicar a ausncia de uma cidade.
+ */
+constexpr CityId NO_CITY = std::numeric_limits<CityId>::max();
+
+/**
+ * \struct Edge
+ * \brief Estrada de uma lista de arestas, usada para construir um `Graph`.
+ */
+struct Edge {
+	/**
+	 * \brief Cidade de origem da estrada.
+	 */
+	CityId source;
+
+	/**
+	 * \brief Cidade de destino da estrada.
+	 */
+	CityId target;
+
+	/**
+	 * \brief Peso da estrada.
+	 */
+	Weight weight = 1;
+};
+
+/**
+ * \class Graph
+ * \brief Grafo direcionado compacto no formato CSR (compressed sparse row).
+ *
+ * As arestas de todas as cidades ficam em um nico vetor contguo de destinos,
+ * e `m_offsets[v]..m_offsets[v + 1]` delimita as arestas que saem da cidade `v`.
+ * Os pesos s so armazenados quando alguma estrada tem peso diferente de 1.
+ * O grafo  construdo uma nica vez e no  alterado depois disso.
+ */
+class Graph {
+public:
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria um grafo vazio, sem cidades nem estradas.
+	 */
+	Graph();
+
+	/**
+	 * \brief Constri o grafo a partir de uma lista de arestas.
+	 *
+	 * \param nodeCount Nmero de cidades do grafo.
+	 * \param edges Estradas do grafo. A ordem das estradas de uma mesma origem  preservada.
+	 *
+	 * \note Complexidade: O(V + E), usando uma ordenao por contagem sobre as origens.
+	 */
+	Graph(std::size_t nodeCount, const std::vector<Edge>& edges);
+
+	/**
+	 * \brief Constri o grafo a partir de cidades ligadas por `Road`s.
+	 *
+	 * \param cities Cidades do grafo. O identificador de cada cidade  sua posio no vetor.
+	 * \return O grafo induzido pelas cidades fornecidas.
+	 *
+	 * As estradas so associadas s cidades pelo ndice (`City::getIndex`), e estradas
+	 * que apontam para cidades fora do vetor so descartadas.
+	 *
+	 * \note Complexidade: O(V + E).
+	 */
+	static Graph fromCities(const std::vector<City>& cities);
+
+	/**
+	 * \brief Obtm o nmero de cidades do grafo.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * \brief Obtm o nmero de estradas do grafo.
+	 */
+	std::size_t edgeCount() const;
+
+	/**
+	 * \brief Obtm a primeira aresta que sai de uma cidade.
+	 */
+	EdgeIndex begin(CityId node) const { return m_offsets[node]; }
+
+	/**
+	 * \brief Obtm a posio seguinte  ltima aresta que sai de uma cidade.
+	 */
+	EdgeIndex end(CityId node) const { return m_offsets[node + 1]; }
+
+	/**
+	 * \brief Obtm o destino de uma aresta.
+	 */
+	CityId target(EdgeIndex edge) const { return m_targets[edge]; }
+
+	/**
+	 * \brief Obtm o peso de uma aresta.
+	 */
+	Weight weight(EdgeIndex edge) const { return m_weights.empty() ? 1 : m_weights[edge]; }
+
+	/**
+	 * \brief Obtm os vizinhos de sada de uma cidade.
+	 * \return Uma viso sobre os destinos das estradas que saem de `node`, na ordem de insero.
+	 */
+	std::span<const CityId> neighbors(CityId node) const;
+
+	/**
+	 * \brief Verifica se alguma estrada tem peso diferente de 1.
+	 */
+	bool isWeighted() const;
+
+	/**
+	 * \brief Obtm o maior peso entre as estradas, ou 1 se o grafo no tiver pesos.
+	 */
+	Weight maxWeight() const { return m_maxWeight; }
+
+	/**
+	 * \brief Cria o grafo transposto, com todas as estradas invertidas.
+	 *
+	 * As estradas que chegam em uma cidade ficam ordenadas pela origem e, em seguida,
+	 * pela ordem de insero.
+	 *
+	 * \note Complexidade: O(V + E).
+	 */
+	Graph transpose() const;
+
+private:
+	/**
+	 * \brief Incio das arestas de cada cidade; possui V + 1 posies.
+	 */
+	std::vector<EdgeIndex> m_offsets;
+
+	/**
+	 * \brief Destino de cada aresta, agrupado por origem.
+	 */
+	std::vector<CityId> m_targets;
+
+	/**
+	 * \brief Peso de cada aresta; vazio quando todas as estradas tm peso 1.
+	 */
+	std::vector<Weight> m_weights;
+
+	/**
+	 * \brief Maior peso em `m_weights`.
+	 */
+	Weight m_maxWeight = 1;
+};
+
+#endif // Graph_H
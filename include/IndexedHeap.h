@@ -0,0 +1,120 @@
+#ifndef IndexedHeap_H
+#define IndexedHeap_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Graph.h"
+
+/**
+ * \class IndexedHeap
+ * \brief Heap 4-rio de mnimo indexado pelo identificador da cidade, com diminuio de chave.
+ *
+ * Cada cidade aparece no heap no mximo uma vez: inserir uma cidade que j est nele
+ * apenas diminui a sua distncia, movendo-a no lugar. O heap nunca passa de V entradas
+ * e nenhuma retirada devolve uma distncia desatualizada, ao contrrio de uma fila de
+ * prioridade com remoo preguiosa, que cresce at O(E).
+ *
+ * Com 4 filhos por n, a rvore tem metade da altura de um heap binrio: a subida, usada
+ * pelas inseres e diminuies (as operaes mais frequentes em um Dijkstra), anda metade
+ * dos nveis, e os filhos de um n ficam lado a lado na memria.
+ *
+ * A posio de cada cidade no heap  guardada em um vetor indexado pelo identificador,
+ * que cresce conforme cidades maiores so inseridas e  reaproveitado entre as buscas.
+ */
+class IndexedHeap {
+public:
+	/**
+	 * \brief Cria um heap vazio.
+	 * \param size Nmero de cidades esperado, para reservar o ndice de posies.
+	 */
+	explicit IndexedHeap(std::size_t size = 0);
+
+	/**
+	 * \brief Verifica se o heap est vazio.
+	 */
+	bool empty() const { return m_heap.empty(); }
+
+	/**
+	 * \brief Obtm o nmero de cidades no heap.
+	 */
+	std::size_t size() const { return m_heap.size(); }
+
+	/**
+	 * \brief Verifica se uma cidade est no heap.
+	 */
+	bool contains(CityId node) const { return node < m_position.size() && m_position[node] != ABSENT; }
+
+	/**
+	 * \brief Insere uma cidade ou diminui a sua distncia, se ela j estiver no heap.
+	 *
+	 * \param node A cidade.
+	 * \param distance A nova distncia. Uma distncia maior que a atual  ignorada.
+	 * \return Falso se a cidade j estava no heap com uma distncia menor ou igual.
+	 *
+	 * \note Complexidade: O(log n).
+	 */
+	bool push(CityId node, Distance distance);
+
+	/**
+	 * \brief Retira a cidade de menor distncia; entre distncias iguais, a de menor identificador.
+	 *
+	 * \param distance Recebe a distncia da cidade.
+	 * \return A cidade. O heap no pode estar vazio.
+	 *
+	 * \note Complexidade: O(log n).
+	 */
+	CityId pop(Distance& distance);
+
+	/**
+	 * \brief Esvazia o heap, mantendo a memria alocada.
+	 *
+	 * \note Complexidade: O(n), onde n  o nmero de cidades que ainda estavam no heap.
+	 */
+	void clear();
+
+private:
+	/**
+	 * \brief Nmero de filhos de cada n.
+	 */
+	static constexpr std::size_t ARITY = 4;
+
+	/**
+	 * \brief Posio de uma cidade que no est no heap.
+	 */
+	static constexpr std::uint32_t ABSENT = UINT32_MAX;
+
+	struct Entry {
+		Distance distance;
+		CityId node;
+
+		bool operator<(const Entry& other) const {
+			return distance < other.distance || (distance == other.distance && node < other.node);
+		}
+	};
+
+	/**
+	 * \brief Move a entrada da posio `index` para cima at o seu lugar.
+	 */
+	void siftUp(std::size_t index);
+
+	/**
+	 * \brief Move a entrada da posio `index` para baixo at o seu lugar.
+	 */
+	void siftDown(std::size_t index);
+
+	/**
+	 * \brief Coloca uma entrada na posio `index`, atualizando o ndice.
+	 */
+	void place(std::size_t index, const Entry& entry);
+
+	std::vector<Entry> m_heap;
+
+	/**
+	 * \brief Posio de cada cidade em `m_heap`, ou `ABSENT`.
+	 */
+	std::vector<std::uint32_t> m_position;
+};
+
+#endif // IndexedHeap_H
@@ -0,0 +1,128 @@
+#ifndef MapReader_H
+#define MapReader_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Graph.h"
+
+/**
+ * \class MapReader
+ * \brief Leitor do mapa de entrada (`V E` seguido de E pares de nomes de cidades).
+ *
+ * Cada estrada pode trazer, na mesma linha, um terceiro campo com o seu peso, um inteiro
+ * positivo. Estradas sem peso tm peso 1.
+ *
+ * Quando a entrada  um arquivo regular, ele  mapeado na memria com `mmap` e lido sem
+ * nenhuma cpia. Caso contrrio (um pipe, por exemplo), a entrada  lida inteira para um
+ * nico buffer em blocos grandes.
+ *
+ * Os nomes das cidades so `std::string_view`s apontando para esses bytes e so
+ * internados em identificadores densos (0..V-1, na ordem da primeira apario) por uma
+ * tabela hash de endereamento aberto. Nenhuma string  alocada por estrada, e as
+ * estradas j saem no formato usado para construir o `Graph`.
+ *
+ * Os nomes s so vlidos enquanto o leitor existir.
+ */
+class MapReader {
+public:
+	/**
+	 * \brief Carrega toda a entrada de um descritor de arquivo.
+	 * \param fd Descritor aberto para leitura. No  fechado pelo leitor.
+	 */
+	explicit MapReader(int fd);
+
+	/**
+	 * \brief Libera o mapeamento ou o buffer da entrada.
+	 */
+	~MapReader();
+
+	MapReader(const MapReader&) = delete;
+	MapReader& operator=(const MapReader&) = delete;
+
+	/**
+	 * \brief Interpreta a entrada, preenchendo `names` e `edges`.
+	 *
+	 * \return Falso se a entrada terminar antes do nmero de estradas declarado ou se
+	 *         algum peso no for um inteiro positivo.
+	 *
+	 * \note Complexidade: O(N), onde N  o tamanho da entrada em bytes.
+	 */
+	bool parse();
+
+	/**
+	 * \brief Indica se a entrada foi mapeada na memria, e no copiada para um buffer.
+	 */
+	bool isMapped() const { return m_mapped; }
+
+	/**
+	 * \brief Obtm o nmero de cidades declarado no cabealho da entrada.
+	 */
+	std::size_t cityCount() const { return m_cityCount; }
+
+	/**
+	 * \brief Obtm o nome de cada cidade, indexado pelo seu identificador.
+	 */
+	const std::vector<std::string_view>& names() const { return m_names; }
+
+	/**
+	 * \brief Obtm as estradas lidas, na ordem da entrada.
+	 */
+	const std::vector<Edge>& edges() const { return m_edges; }
+
+	/**
+	 * \brief L o prximo token, ou um token vazio no fim da entrada.
+	 *
+	 * Depois de `parse`, continua a leitura do que vier aps as estradas do mapa.
+	 */
+	std::string_view next();
+
+	/**
+	 * \brief L o prximo token da linha atual, ou um token vazio se a linha terminou.
+	 *
+	 * Usado para os campos opcionais no fim de uma linha, como o peso de uma estrada.
+	 */
+	std::string_view nextOnLine();
+
+	/**
+	 * \brief Converte o peso de uma estrada.
+	 * \return Falso se o token no for um inteiro positivo que caiba em um `Weight`.
+	 */
+	static bool parseWeight(std::string_view token, Weight& weight);
+
+private:
+	/**
+	 * \brief Obtm o identificador de um nome, criando um novo se ele ainda no existir.
+	 */
+	CityId intern(std::string_view name);
+
+	/**
+	 * \brief Dobra a tabela hash e reinsere todos os nomes.
+	 */
+	void grow();
+
+	/**
+	 * \brief Bytes da entrada, mapeados ou copiados.
+	 */
+	const char* m_data = nullptr;
+	std::size_t m_size = 0;
+	std::size_t m_position = 0;
+	bool m_mapped = false;
+
+	/**
+	 * \brief Buffer da entrada quando ela no pode ser mapeada.
+	 */
+	std::vector<char> m_buffer;
+
+	std::size_t m_cityCount = 0;
+	std::vector<std::string_view> m_names;
+	std::vector<Edge> m_edges;
+
+	/**
+	 * \brief Tabela hash de endereamento aberto: identificador do nome, ou `NO_CITY` se vazia.
+	 */
+	std::vector<CityId> m_slots;
+};
+
+#endif // MapReader_H
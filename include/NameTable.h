@@ -0,0 +1,95 @@
+#ifndef NameTable_H
+#define NameTable_H
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief Identificador de um nome em uma `NameTable`.
+ */
+using NameId = std::uint32_t;
+
+/**
+ * \brief Valor reservado para indicar uma cidade sem nome.
+ */
+constexpr NameId NO_NAME = std::numeric_limits<NameId>::max();
+
+/**
+ * \class NameTable
+ * \brief Tabela central com os nomes das cidades.
+ *
+ * Todos os nomes ficam em um nico vetor de bytes, um aps o outro, e um vetor de
+ * deslocamentos indica onde cada um comea. Assim, uma `City` guarda apenas o
+ * identificador de 32 bits do seu nome, e o texto s  consultado na sada.
+ */
+class NameTable {
+public:
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria uma tabela vazia.
+	 */
+	NameTable();
+
+	/**
+	 * \brief Reserva espao para os nomes.
+	 * \param names Nmero de nomes.
+	 * \param bytes Soma dos tamanhos dos nomes.
+	 */
+	void reserve(std::size_t names, std::size_t bytes);
+
+	/**
+	 * \brief Acrescenta um nome  tabela.
+	 * \param name O nome, copiado para a tabela.
+	 * \return O identificador do nome, igual ao nmero de nomes anteriores.
+	 */
+	NameId add(std::string_view name);
+
+	/**
+	 * \brief Obtm um nome.
+	 * \param id Identificador do nome. `NO_NAME` resulta em um nome vazio.
+	 * \return O nome, vlido enquanto a tabela no for alterada.
+	 */
+	std::string_view get(NameId id) const;
+
+	/**
+	 * \brief Procura um nome na tabela.
+	 *
+	 * O ndice de busca (uma tabela hash de endereamento aberto) s  construdo na
+	 * primeira chamada e depois  mantido por `add`, para que a leitura do mapa no pague por ele.
+	 *
+	 * \param name O nome procurado.
+	 * \return O identificador do nome, ou `NO_NAME` se ele no estiver na tabela.
+	 */
+	NameId find(std::string_view name);
+
+	/**
+	 * \brief Obtm o nmero de nomes da tabela.
+	 */
+	std::size_t size() const { return m_offsets.size() - 1; }
+
+private:
+	/**
+	 * \brief Bytes de todos os nomes, concatenados.
+	 */
+	std::vector<char> m_bytes;
+
+	/**
+	 * \brief Incio de cada nome em `m_bytes`; possui size() + 1 posies.
+	 */
+	std::vector<std::uint32_t> m_offsets;
+
+	/**
+	 * \brief ndice de busca: identificador do nome, ou `NO_NAME` se vazia. Vazio at o primeiro `find`.
+	 */
+	std::vector<NameId> m_slots;
+
+	/**
+	 * \brief Insere um nome no ndice, dobrando-o se ele ficar mais que metade cheio.
+	 */
+	void index(NameId id);
+};
+
+#endif // NameTable_H
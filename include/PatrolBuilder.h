@@ -0,0 +1,139 @@
+#ifndef PatrolBuilder_H
+#define PatrolBuilder_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Components.h"
+#include "Graph.h"
+#include "SearchWorkspace.h"
+
+/**
+ * \class PatrolBuilder
+ * \brief Constri as rotas de patrulha de cada componente fortemente conectada.
+ *
+ * A patrulha de uma componente percorre as estradas no sentido em que podem ser
+ * trafegadas, a partir da raiz da componente. O subgrafo induzido pela componente no 
+ * copiado: as buscas andam sobre o grafo compartilhado e ignoram as estradas cujo destino
+ * est em outra componente (`Components::componentOf` funciona como uma mscara). O grafo
+ * transposto s  usado para achar os predecessores de uma cidade no caminho de volta.
+ *
+ * A rota  formada por:
+ * 1. As cidades na ordem de descoberta de uma DFS a partir da raiz. Quando a prxima
+ *    cidade descoberta no  vizinha da anterior, a DFS voltou: a cidade de onde ela
+ *    foi descoberta  inserida antes dela.
+ * 2. O caminho mais curto de volta da ltima cidade at a raiz, sem repetir a raiz.
+ *    Entre caminhos de mesmo tamanho, cada cidade do caminho vem da vizinha com menor
+ *    posio na ordem em que uma DFS pelas estradas invertidas, a partir da raiz, descobre
+ *    as cidades da componente: a ordem em que o Kosaraju lista a componente. O
+ *    caminho  buscado por nveis a partir das duas pontas, at as buscas se encontrarem,
+ *    em vez de uma busca que anda a partir da ltima cidade at achar a raiz. Em um
+ *    grafo com pesos, o tamanho  o peso do caminho, calculado por um Dijkstra com a fila
+ *    de baldes, com o mesmo desempate.
+ *
+ * O estado das buscas  indexado pelo identificador da cidade no grafo e reaproveitado
+ * entre as componentes; cada objeto deve ser usado por uma nica thread.
+ */
+class PatrolBuilder {
+public:
+	/**
+	 * \brief Cria o construtor de patrulhas.
+	 *
+	 * \param graph O grafo original, percorrido pela DFS e pelo caminho de volta.
+	 * \param transposed O grafo com as estradas invertidas (`Graph::transpose`), percorrido pela
+	 *        busca que parte da raiz no caminho de volta.
+	 * \param components As componentes fortemente conectadas do grafo original.
+	 *
+	 * Os trs objetos devem permanecer vlidos enquanto o construtor for usado.
+	 */
+	PatrolBuilder(const Graph& graph, const Graph& transposed, const Components& components);
+
+	/**
+	 * \brief Constri a patrulha de uma componente.
+	 *
+	 * \param component A componente percorrida.
+	 * \param patrol Vetor onde as cidades da rota so acrescentadas.
+	 *
+	 * \note Complexidade: O(n + m), onde n  o nmero de cidades da componente e m  o
+	 *       nmero de estradas que saem delas ou chegam nelas.
+	 */
+	void build(ComponentId component, std::vector<CityId>& patrol);
+
+private:
+	/**
+	 * \brief Quadro da pilha explcita da DFS.
+	 */
+	struct Frame {
+		CityId node;
+		EdgeIndex next;
+	};
+
+	/**
+	 * \brief Inicia uma nova busca, invalidando as marcas da anterior.
+	 */
+	void nextSearch();
+
+	/**
+	 * \brief Numera as cidades da componente em `m_rank`, na ordem de desempate do caminho de volta.
+	 */
+	void rankMembers(ComponentId component);
+
+	/**
+	 * \brief Acrescenta a `patrol` o caminho mais curto de `from` at a raiz, sem `from` e sem a raiz.
+	 */
+	void appendReturn(ComponentId component, CityId from, std::vector<CityId>& patrol);
+
+	/**
+	 * \brief `appendReturn` em um grafo sem pesos: busca em largura a partir de `from` e da raiz ao mesmo tempo.
+	 *
+	 * Deixa em `m_parent` o predecessor de cada cidade do caminho, da raiz at `from`.
+	 */
+	void bidirectionalReturn(ComponentId component, CityId from);
+
+	/**
+	 * \brief `appendReturn` em um grafo com pesos: calcula os predecessores at a raiz com um Dijkstra em `m_workspace`.
+	 */
+	void weightedReturn(ComponentId component, CityId from);
+
+	const Graph& m_graph;
+	const Graph& m_reverse;
+	const Components& m_components;
+
+	/**
+	 * \brief Busca que marcou cada cidade por ltimo; a cidade foi visitada se for igual a `m_search`.
+	 */
+	std::vector<std::uint32_t> m_mark;
+	std::uint32_t m_search = 0;
+
+	/**
+	 * \brief Cidade de onde cada cidade foi alcanada no caminho de volta.
+	 */
+	std::vector<CityId> m_parent;
+
+	/**
+	 * \brief Distncia de cada cidade a partir de `from` no caminho de volta.
+	 */
+	std::vector<std::uint32_t> m_depth;
+
+	/**
+	 * \brief Posio de cada cidade da componente na ordem de desempate (`rankMembers`).
+	 */
+	std::vector<std::uint32_t> m_rank;
+
+	/**
+	 * \brief Sem pesos: distncias at a raiz no caminho de volta. Com pesos: distncias,
+	 *        predecessores e fila do Dijkstra do caminho de volta.
+	 */
+	SearchWorkspace m_workspace;
+
+	std::vector<Frame> m_stack;
+
+	/**
+	 * \brief ltimo nvel de cada lado da busca do caminho de volta e o prximo nvel em construo.
+	 */
+	std::vector<CityId> m_level;
+	std::vector<CityId> m_rootLevel;
+	std::vector<CityId> m_nextLevel;
+};
+
+#endif // PatrolBuilder_H
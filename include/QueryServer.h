@@ -0,0 +1,82 @@
+#ifndef QueryServer_H
+#define QueryServer_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DynamicArchadian.h"
+#include "SearchWorkspace.h"
+
+/**
+ * \class QueryServer
+ * \brief Responde consultas sobre um mapa carregado uma nica vez.
+ *
+ * Cada consulta  uma linha, e cada resposta tambm:
+ * - `capital`: o nome da capital.
+ * - `route A B`: as cidades de uma rota mais curta de A at B, ou `-` se no houver rota.
+ * - `scc A`: o nmero de cidades da componente de A, seguido dos seus nomes.
+ * - `battalion A`: o batalho da componente de A, isto , o seu representante.
+ * - `+ A B [peso]` e `- A B`: abrem e fecham uma estrada, respondendo `ok`.
+ * - `quit`: encerra a conexo, sem resposta.
+ *
+ * Consultas invlidas ou com cidades desconhecidas so respondidas com uma linha
+ * comeando por `?`.
+ *
+ * As componentes j calculadas pelo `DynamicArchadian` respondem `scc` e `battalion` em
+ * O(1) por cidade e descartam em O(1) rotas impossveis. A rota  buscada a partir das
+ * duas pontas ao mesmo tempo (`Algorithms::BidirectionalSearch`), at as buscas se
+ * encontrarem: cada lado s anda cerca de metade do caminho. A busca a partir da origem
+ * ignora as componentes que vm depois do destino na ordem topolgica, a busca a partir
+ * do destino ignora as que vm antes da origem, e o estado das duas  reaproveitado entre
+ * as consultas. Se alguma estrada tiver peso, a rota mais curta  a de menor peso.
+ */
+class QueryServer {
+public:
+	/**
+	 * \brief Cria o servidor sobre um mapa. O mapa deve permanecer vlido enquanto o servidor for usado.
+	 */
+	explicit QueryServer(DynamicArchadian& map);
+
+	/**
+	 * \brief Responde uma consulta.
+	 *
+	 * \param query A linha da consulta, sem a quebra de linha.
+	 * \param response Recebe a resposta, terminada por uma quebra de linha (vazia para `quit`).
+	 * \return Falso se a consulta encerra a conexo.
+	 */
+	bool answer(std::string_view query, std::string& response);
+
+	/**
+	 * \brief L consultas de `in` e escreve as respostas em `out` at o fim da entrada ou um `quit`.
+	 */
+	void serve(int in, int out);
+
+	/**
+	 * \brief Escuta um socket Unix em `path` e atende as conexes, uma de cada vez, indefinidamente.
+	 * \return Falso se o socket no puder ser criado.
+	 */
+	bool listen(const char* path);
+
+private:
+	/**
+	 * \brief Encontra uma rota mais curta de `source` at `target`, acrescentando-a a `response`.
+	 */
+	void route(CityId source, CityId target, std::string& response);
+
+	DynamicArchadian& m_map;
+
+	/**
+	 * \brief Distncias, predecessores e filas das buscas a partir da origem e a partir do destino,
+	 *        invalidados em O(1) entre as consultas.
+	 */
+	SearchWorkspace m_forward;
+	SearchWorkspace m_backward;
+
+	/**
+	 * \brief Cidades da ltima rota encontrada.
+	 */
+	std::vector<CityId> m_path;
+};
+
+#endif // QueryServer_H
@@ -19,11 +19,12 @@ public:
 	 * \brief Construtor de Road.
 	 * \param source N de origem da aresta.
 	 * \param target N de destino da aresta.
+	 * \param weight Tempo de viagem da estrada.
 	 *
 	 * Cria uma instncia de `Road` que conecta o n de origem ao n de destino.
 	 * Inicializa o peso padro como 1, caso no seja especificado.
 	 */
-	Road(City* source, City* target);
+	Road(City* source, City* target, int weight = 1);
 
 	/**
 	 * \brief Obtm o n de origem da aresta.
@@ -0,0 +1,117 @@
+#ifndef SearchWorkspace_H
+#define SearchWorkspace_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "BucketQueue.h"
+#include "Graph.h"
+
+/**
+ * \class SearchWorkspace
+ * \brief Estado de buscas de caminhos mais curtos repetidas, reaproveitado entre elas.
+ *
+ * Guarda a distncia, o predecessor e as marcas de alcanada e fixada de cada cidade, em
+ * vetores indexados pelo identificador. As marcas so nmeros de poca: uma cidade foi
+ * alcanada pela busca atual se a sua marca for igual  poca atual, ento `start` invalida
+ * todo o estado anterior em O(1), incrementando a poca. Uma busca s escreve nas cidades
+ * que alcana, e as cidades alcanadas ficam listadas em `touched`.
+ *
+ * O espao tambm guarda a fila de prioridade da busca, recriada apenas quando o maior
+ * peso muda. Cada objeto deve ser usado por uma nica thread.
+ */
+class SearchWorkspace {
+public:
+	/**
+	 * \brief Distncia de uma cidade que no foi alcanada.
+	 */
+	static constexpr Distance UNREACHED = std::numeric_limits<Distance>::max();
+
+	/**
+	 * \brief Cria o espao de busca.
+	 * \param size Nmero de cidades do grafo; o espao cresce se `start` receber um nmero maior.
+	 */
+	explicit SearchWorkspace(std::size_t size = 0);
+
+	/**
+	 * \brief Inicia uma nova busca, esquecendo todas as cidades alcanadas pela anterior.
+	 *
+	 * \param size Nmero de cidades do grafo da busca.
+	 *
+	 * \note Complexidade: O(1), exceto quando o grafo cresce ou a poca d a volta.
+	 */
+	void start(std::size_t size);
+
+	/**
+	 * \brief Obtm a fila de prioridade da busca, esvaziada por `start`.
+	 * \param maxWeight O maior peso das estradas da busca (`Graph::maxWeight`).
+	 */
+	BucketQueue& queue(Weight maxWeight);
+
+	/**
+	 * \brief Verifica se uma cidade foi alcanada pela busca atual.
+	 */
+	bool reached(CityId node) const { return m_reached[node] == m_epoch; }
+
+	/**
+	 * \brief Verifica se a distncia de uma cidade j  definitiva na busca atual.
+	 */
+	bool settled(CityId node) const { return m_settled[node] == m_epoch; }
+
+	/**
+	 * \brief Obtm a distncia de uma cidade, ou `UNREACHED` se ela no foi alcanada.
+	 */
+	Distance distance(CityId node) const { return reached(node) ? m_distance[node] : UNREACHED; }
+
+	/**
+	 * \brief Obtm o predecessor de uma cidade alcanada, ou `NO_CITY` para a origem.
+	 */
+	CityId parent(CityId node) const { return m_parent[node]; }
+
+	/**
+	 * \brief Define a distncia e o predecessor de uma cidade, marcando-a como alcanada.
+	 */
+	void reach(CityId node, Distance distance, CityId parent) {
+		if (m_reached[node] != m_epoch) {
+			m_reached[node] = m_epoch;
+			m_touched.push_back(node);
+		}
+		m_distance[node] = distance;
+		m_parent[node] = parent;
+	}
+
+	/**
+	 * \brief Troca o predecessor de uma cidade alcanada, mantendo a distncia.
+	 */
+	void setParent(CityId node, CityId parent) { m_parent[node] = parent; }
+
+	/**
+	 * \brief Marca a distncia de uma cidade alcanada como definitiva.
+	 */
+	void settle(CityId node) { m_settled[node] = m_epoch; }
+
+	/**
+	 * \brief Obtm as cidades alcanadas pela busca atual, na ordem em que foram alcanadas.
+	 */
+	std::span<const CityId> touched() const { return m_touched; }
+
+private:
+	/**
+	 * \brief poca em que cada cidade foi alcanada e fixada por ltimo.
+	 */
+	std::vector<std::uint32_t> m_reached;
+	std::vector<std::uint32_t> m_settled;
+	std::uint32_t m_epoch = 0;
+
+	std::vector<Distance> m_distance;
+	std::vector<CityId> m_parent;
+	std::vector<CityId> m_touched;
+
+	BucketQueue m_queue{ 1 };
+	Weight m_queueWeight = 1;
+};
+
+#endif // SearchWorkspace_H
@@ -0,0 +1,149 @@
+#ifndef ShortestPathTree_H
+#define ShortestPathTree_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Graph.h"
+#include "SearchWorkspace.h"
+
+/**
+ * \class ShortestPathTree
+ * \brief rvore de caminhos mais curtos a partir de uma origem: a distncia e o predecessor de cada cidade.
+ *
+ * O resultado de um Dijkstra ocupa dois vetores de V posies, independente do tamanho dos
+ * caminhos. Nenhum caminho  montado na construo: `walk` percorre os predecessores sob
+ * demanda, do destino at a origem, e `path` monta um nico caminho na ordem da origem
+ * para o destino. Quem precisa de poucos caminhos paga s por eles.
+ */
+class ShortestPathTree {
+public:
+	/**
+	 * \brief Iterador que anda pelos predecessores, do destino at a origem.
+	 */
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = CityId;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const CityId*;
+		using reference = CityId;
+
+		Iterator() = default;
+		Iterator(const ShortestPathTree* tree, CityId node) : m_tree(tree), m_node(node) {}
+
+		CityId operator*() const { return m_node; }
+
+		Iterator& operator++() {
+			m_node = m_tree->parent(m_node);
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator previous = *this;
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+
+	private:
+		const ShortestPathTree* m_tree = nullptr;
+		CityId m_node = NO_CITY;
+	};
+
+	/**
+	 * \brief Caminho de um destino at a origem, percorrido sob demanda.
+	 */
+	struct Walk {
+		Iterator first;
+
+		Iterator begin() const { return first; }
+		Iterator end() const { return Iterator(); }
+	};
+
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria uma rvore vazia, que no alcana nenhuma cidade.
+	 */
+	ShortestPathTree();
+
+	/**
+	 * \brief Copia o resultado de uma busca.
+	 *
+	 * \param source A origem da busca.
+	 * \param size Nmero de cidades do grafo.
+	 * \param workspace O espao onde a busca foi feita (`Algorithms::Dijkstra`).
+	 *
+	 * \note Complexidade: O(V) para alocar os vetores, mais O(1) por cidade alcanada.
+	 */
+	ShortestPathTree(CityId source, std::size_t size, const SearchWorkspace& workspace);
+
+	/**
+	 * \brief Obtm a origem da busca, ou `NO_CITY` em uma rvore vazia.
+	 */
+	CityId source() const { return m_source; }
+
+	/**
+	 * \brief Obtm o nmero de cidades do grafo.
+	 */
+	std::size_t size() const { return m_parent.size(); }
+
+	/**
+	 * \brief Verifica se a origem alcana uma cidade. A origem alcana a si mesma.
+	 */
+	bool reaches(CityId node) const { return node < size() && m_distance[node] != SearchWorkspace::UNREACHED; }
+
+	/**
+	 * \brief Obtm a distncia da origem at uma cidade, ou `SearchWorkspace::UNREACHED`.
+	 */
+	Distance distance(CityId node) const { return reaches(node) ? m_distance[node] : SearchWorkspace::UNREACHED; }
+
+	/**
+	 * \brief Obtm o predecessor de uma cidade no caminho mais curto, ou `NO_CITY` para a origem e
+	 *        para as cidades no alcanadas.
+	 */
+	CityId parent(CityId node) const { return m_parent[node]; }
+
+	/**
+	 * \brief Percorre o caminho de um destino at a origem, incluindo os dois.
+	 *
+	 * \return Um intervalo vazio se o destino no for alcanado.
+	 *
+	 * \note Complexidade: O(1); cada passo do iterador custa O(1).
+	 */
+	Walk walk(CityId target) const { return Walk{ Iterator(this, reaches(target) ? target : NO_CITY) }; }
+
+	/**
+	 * \brief Obtm o nmero de estradas do caminho at um destino, ou 0 se ele no for alcanado.
+	 *
+	 * \note Complexidade: O(k), onde k  o nmero de estradas do caminho.
+	 */
+	std::size_t hops(CityId target) const;
+
+	/**
+	 * \brief Monta o caminho at um destino, da primeira cidade depois da origem at o destino.
+	 *
+	 * \return O caminho, vazio para a prpria origem e para as cidades no alcanadas.
+	 *
+	 * \note Complexidade: O(k), onde k  o nmero de estradas do caminho.
+	 */
+	std::vector<CityId> path(CityId target) const;
+
+private:
+	CityId m_source = NO_CITY;
+
+	/**
+	 * \brief Distncia de cada cidade, ou `SearchWorkspace::UNREACHED`.
+	 */
+	std::vector<Distance> m_distance;
+
+	/**
+	 * \brief Predecessor de cada cidade, ou `NO_CITY`.
+	 */
+	std::vector<CityId> m_parent;
+};
+
+#endif // ShortestPathTree_H
@@ -0,0 +1,152 @@
+#ifndef Snapshot_H
+#define Snapshot_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "Archadian.h"
+#include "Components.h"
+#include "Graph.h"
+
+/**
+ * \brief Cabealho do arquivo de um `Snapshot`, definido junto com o formato.
+ */
+struct SnapshotHeader;
+
+/**
+ * \class Snapshot
+ * \brief Mapa pr-processado em um arquivo binrio, lido com `mmap` sem nenhuma cpia.
+ *
+ * O arquivo guarda tudo o que a leitura do texto e os clculos produzem: as estradas
+ * no formato CSR (de sada e de entrada, com os pesos se houver), os nomes das cidades,
+ * a componente de cada cidade, a capital, os batalhes e as patrulhas. Ele  escrito
+ * uma nica vez (`write`) e depois mapeado somente para leitura, ento abrir um mapa
+ * custa O(1) independente do seu tamanho, e processos diferentes compartilham as mesmas
+ * pginas na memria.
+ *
+ * O arquivo comea com um cabealho de tamanho fixo, com um identificador, a verso do
+ * formato e o nmero de elementos de cada seo. As sees vm em seguida, na ordem do
+ * cabealho, cada uma alinhada a 8 bytes. Os inteiros esto na ordem de bytes da mquina
+ * que escreveu o arquivo, que  verificada na abertura.
+ */
+class Snapshot {
+public:
+	/**
+	 * \brief Verso do formato. Arquivos de outra verso so recusados.
+	 */
+	static constexpr std::uint32_t VERSION = 1;
+
+	/**
+	 * \brief Escreve o mapa em um arquivo.
+	 *
+	 * O arquivo  escrito ao lado do destino e renomeado no final, ento um leitor nunca
+	 * mapeia um arquivo incompleto.
+	 *
+	 * \param archadian O mapa, aps `calcCapital` e `calcBattalionsAndPatrolling`.
+	 * \param path Caminho do arquivo.
+	 * \return Falso se o arquivo no puder ser escrito.
+	 *
+	 * \note Complexidade: O(V + E).
+	 */
+	static bool write(const Archadian& archadian, const char* path);
+
+	/**
+	 * \brief Mapeia um arquivo escrito por `write`.
+	 * \param path Caminho do arquivo. Use `isValid` para saber se ele pde ser aberto.
+	 */
+	explicit Snapshot(const char* path);
+
+	/**
+	 * \brief Desfaz o mapeamento.
+	 */
+	~Snapshot();
+
+	Snapshot(const Snapshot&) = delete;
+	Snapshot& operator=(const Snapshot&) = delete;
+
+	/**
+	 * \brief Indica se o arquivo foi mapeado e tem o formato e a verso esperados.
+	 */
+	bool isValid() const { return m_header != nullptr; }
+
+	/**
+	 * \brief Obtm o nmero de cidades.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * \brief Obtm os destinos das estradas que saem de uma cidade.
+	 */
+	std::span<const CityId> neighbors(CityId city) const;
+
+	/**
+	 * \brief Obtm as origens das estradas que chegam em uma cidade.
+	 */
+	std::span<const CityId> predecessors(CityId city) const;
+
+	/**
+	 * \brief Obtm os pesos das estradas de `neighbors(city)`, ou nada se todas as estradas tiverem peso 1.
+	 */
+	std::span<const Weight> weights(CityId city) const;
+
+	/**
+	 * \brief Obtm o nome de uma cidade, ou um nome vazio para `NO_CITY`.
+	 */
+	std::string_view getName(CityId city) const;
+
+	/**
+	 * \brief Obtm o nmero de componentes fortemente conectadas.
+	 */
+	std::size_t componentCount() const;
+
+	/**
+	 * \brief Obtm a componente de uma cidade; as componentes esto em ordem topolgica.
+	 */
+	ComponentId componentOf(CityId city) const { return m_component[city]; }
+
+	/**
+	 * \brief Obtm a capital, ou `NO_CITY` se no houver capital.
+	 */
+	CityId getCapital() const;
+
+	/**
+	 * \brief Obtm os batalhes, na mesma ordem de `Archadian::getBattalions`.
+	 */
+	Battalions getBattalions() const { return m_battalions; }
+
+	/**
+	 * \brief Verifica se h batalhes, como `Archadian::hasBattalions`.
+	 */
+	bool hasBattalions() const;
+
+	/**
+	 * \brief Obtm o nmero de patrulhas.
+	 */
+	std::size_t getPatrolCount() const { return m_patrolOffsets.size() - 1; }
+
+	/**
+	 * \brief Obtm a rota de uma patrulha, sem cpia.
+	 */
+	Patrolling getPatrolling(std::size_t patrol) const;
+
+private:
+	const SnapshotHeader* m_header = nullptr;
+	const char* m_data = nullptr;
+	std::size_t m_size = 0;
+
+	std::span<const EdgeIndex> m_outOffsets;
+	std::span<const CityId> m_outTargets;
+	std::span<const Weight> m_outWeights;
+	std::span<const EdgeIndex> m_inOffsets;
+	std::span<const CityId> m_inSources;
+	std::span<const std::uint32_t> m_nameOffsets;
+	std::span<const char> m_nameBytes;
+	std::span<const ComponentId> m_component;
+	std::span<const CityId> m_battalions;
+	std::span<const std::uint64_t> m_patrolOffsets;
+	std::span<const CityId> m_patrolCities;
+};
+
+#endif // Snapshot_H
@@ -0,0 +1,130 @@
+#ifndef ThreadPool_H
+#define ThreadPool_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class ThreadPool
+ * \brief Conjunto fixo de threads que executa lotes de tarefas independentes.
+ *
+ * As threads so criadas uma nica vez e reaproveitadas por todas as chamadas de `run`.
+ * A thread que chama `run` tambm executa tarefas, como o trabalhador 0, ento um
+ * conjunto de tamanho 1 no cria nenhuma thread e executa tudo sequencialmente.
+ *
+ * Cada tarefa recebe o ndice do trabalhador que a executa, permitindo que o chamador
+ * mantenha uma rea de trabalho por thread sem nenhuma sincronizao.
+ *
+ * As tarefas de um lote so divididas em faixas contguas, uma por trabalhador. Cada
+ * trabalhador consome a sua faixa do incio para o fim e, quando ela acaba, rouba a
+ * metade final da faixa de outro trabalhador (work stealing). Assim, uma tarefa muito
+ * mais demorada que as outras ocupa um nico trabalhador enquanto os demais dividem o resto.
+ */
+class ThreadPool {
+public:
+	/**
+	 * \brief Funo executada para cada tarefa, com `(task, worker)`.
+	 */
+	using Task = std::function<void(std::size_t task, std::size_t worker)>;
+
+	/**
+	 * \brief Cria o conjunto de threads.
+	 * \param threads Nmero total de trabalhadores, incluindo a thread que chama `run`.
+	 *                O valor 0 usa o nmero de processadores da mquina.
+	 */
+	explicit ThreadPool(std::size_t threads);
+
+	/**
+	 * \brief Encerra e aguarda todas as threads.
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * \brief Obtm o nmero de trabalhadores.
+	 */
+	std::size_t size() const { return m_threads.size() + 1; }
+
+	/**
+	 * \brief Executa as tarefas 0..count-1 e aguarda todas terminarem.
+	 *
+	 * A ordem de execuo e o trabalhador de cada tarefa no so determinsticos, ento
+	 * cada tarefa deve escrever apenas no seu prprio resultado.
+	 *
+	 * \param count Nmero de tarefas.
+	 * \param task Funo executada para cada tarefa.
+	 */
+	void run(std::size_t count, const Task& task);
+
+private:
+	/**
+	 * \brief Lao das threads auxiliares: aguarda um lote e executa as suas tarefas.
+	 */
+	void workerLoop(std::size_t worker);
+
+	/**
+	 * \brief Executa tarefas do lote atual at que no reste nenhuma livre.
+	 */
+	void drain(std::size_t worker);
+
+	/**
+	 * \brief Pega a prxima tarefa da faixa do trabalhador.
+	 */
+	bool take(std::size_t worker, std::size_t& task);
+
+	/**
+	 * \brief Rouba a metade final da faixa de outro trabalhador e pega a primeira tarefa dela.
+	 */
+	bool steal(std::size_t worker, std::size_t& task);
+
+	/**
+	 * \brief Faixa de tarefas ainda no iniciadas de um trabalhador, [begin, end).
+	 *
+	 * Cada faixa fica na sua prpria linha de cache para que os trabalhadores no disputem a memria.
+	 */
+	struct alignas(64) Range {
+		std::mutex mutex;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+	};
+
+	/**
+	 * \brief Threads auxiliares, trabalhadores 1..size()-1.
+	 */
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+
+	/**
+	 * \brief Lote atual.
+	 */
+	const Task* m_task = nullptr;
+
+	/**
+	 * \brief Faixas de tarefas de cada trabalhador.
+	 */
+	std::unique_ptr<Range[]> m_ranges;
+
+	/**
+	 * \brief Incrementado a cada lote, para acordar as threads auxiliares.
+	 */
+	std::size_t m_generation = 0;
+
+	/**
+	 * \brief Threads auxiliares que ainda no terminaram o lote atual.
+	 */
+	std::size_t m_busy = 0;
+
+	bool m_stop = false;
+};
+
+#endif // ThreadPool_H
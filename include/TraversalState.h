@@ -0,0 +1,141 @@
+#ifndef TraversalState_H
+#define TraversalState_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Graph.h"
+
+enum CityColor {
+	// No foi descobreto.
+	UNDISCOVERED,
+	// Descoberto mas no finalizado.
+	DISCOVERED,
+	// Finalizado.
+	FINISHED
+};
+
+using DiscoveryTime = std::uint32_t;
+using FinishingTime = std::uint32_t;
+
+/**
+ * \class TraversalState
+ * \brief Estado de uma busca em profundidade, indexado pelo identificador denso da cidade.
+ *
+ * As cores so empacotadas em 2 bits por cidade (32 cidades por palavra) e os tempos
+ * de descoberta e finalizao ficam em vetores de 32 bits. Assim, consultar o estado
+ * de uma cidade durante a DFS  um acesso direto a um vetor, sem nenhum hash.
+ *
+ * Alm dos tempos, o estado guarda a ordem de finalizao (ps-ordem) das cidades,
+ * gravada pela DFS  medida que cada cidade  finalizada. Percorr-la de trs para
+ * frente d as cidades em ordem decrescente de tempo de finalizao sem nenhuma ordenao.
+ *
+ * O mesmo objeto pode ser reaproveitado entre buscas com `reset`, sem realocar memria.
+ */
+class TraversalState {
+public:
+	/**
+	 * \brief Construtor padro.
+	 *
+	 * Cria um estado vazio, sem nenhuma cidade.
+	 */
+	TraversalState();
+
+	/**
+	 * \brief Cria um estado com todas as cidades no descobertas.
+	 * \param size Nmero de cidades do grafo percorrido.
+	 */
+	explicit TraversalState(std::size_t size);
+
+	/**
+	 * \brief Marca todas as cidades como no descobertas, zera os tempos e esvazia a ps-ordem.
+	 * \param size Nmero de cidades do grafo percorrido.
+	 *
+	 * \note Complexidade: O(V), reaproveitando a memria j alocada.
+	 */
+	void reset(std::size_t size);
+
+	/**
+	 * \brief Obtm o nmero de cidades do estado.
+	 */
+	std::size_t size() const { return m_discovery.size(); }
+
+	/**
+	 * \brief Obtm a cor de uma cidade.
+	 */
+	CityColor getColor(CityId node) const {
+		return static_cast<CityColor>((m_colors[node >> 5] >> shift(node)) & 3u);
+	}
+
+	/**
+	 * \brief Define a cor de uma cidade.
+	 */
+	void setColor(CityId node, CityColor color) {
+		std::uint64_t& word = m_colors[node >> 5];
+		word = (word & ~(std::uint64_t{ 3 } << shift(node))) | (static_cast<std::uint64_t>(color) << shift(node));
+	}
+
+	/**
+	 * \brief Obtm o tempo de descoberta de uma cidade, ou 0 se ela no foi descoberta.
+	 */
+	DiscoveryTime getDiscoveryTime(CityId node) const { return m_discovery[node]; }
+
+	/**
+	 * \brief Define o tempo de descoberta de uma cidade.
+	 */
+	void setDiscoveryTime(CityId node, DiscoveryTime time) { m_discovery[node] = time; }
+
+	/**
+	 * \brief Obtm o tempo de finalizao de uma cidade, ou 0 se ela no foi finalizada.
+	 */
+	FinishingTime getFinishingTime(CityId node) const { return m_finish[node]; }
+
+	/**
+	 * \brief Define o tempo de finalizao de uma cidade.
+	 */
+	void setFinishingTime(CityId node, FinishingTime time) { m_finish[node] = time; }
+
+	/**
+	 * \brief Acrescenta uma cidade ao fim da ps-ordem.
+	 *
+	 * Chamado pela DFS quando a cidade  finalizada. A memria  reservada em `reset`,
+	 * ento o acrscimo nunca realoca.
+	 */
+	void appendFinished(CityId node) { m_postorder.push_back(node); }
+
+	/**
+	 * \brief Obtm as cidades finalizadas, em ordem crescente de tempo de finalizao.
+	 *
+	 * \note Complexidade: O(1); a ordem  produzida pela prpria DFS.
+	 */
+	std::span<const CityId> getPostorder() const { return m_postorder; }
+
+private:
+	/**
+	 * \brief Deslocamento da cor de uma cidade dentro da sua palavra.
+	 */
+	static unsigned shift(CityId node) { return (node & 31u) * 2u; }
+
+	/**
+	 * \brief Cores das cidades, 2 bits por cidade.
+	 */
+	std::vector<std::uint64_t> m_colors;
+
+	/**
+	 * \brief Tempo de descoberta de cada cidade.
+	 */
+	std::vector<DiscoveryTime> m_discovery;
+
+	/**
+	 * \brief Tempo de finalizao de cada cidade.
+	 */
+	std::vector<FinishingTime> m_finish;
+
+	/**
+	 * \brief Cidades na ordem em que foram finalizadas.
+	 */
+	std::vector<CityId> m_postorder;
+};
+
+#endif // TraversalState_H
@@ -3,127 +3,126 @@
 #include <limits>
 
 #include "Algorithms.h"
+#include "SearchWorkspace.h"
 
 namespace {
 	/**
-	 * \class NullNodeVisitor
-	 * \brief Um visitante de nó nulo que não realiza nenhuma operação.
-	 *
-	 * Essa classe é uma implementação padrão de `NodeVisitor` que não realiza
-	 * nenhuma ação nos nós visitados. Útil como implementação de fallback ou
-	 * quando nenhuma operação é necessária.
+	 * \struct DFSFrame
+	 * \brief Quadro da pilha explícita da DFS: o nó e a próxima aresta a ser examinada.
+	 */
+	struct DFSFrame {
+		CityId node;
+		EdgeIndex next;
+	};
+
+	/**
+	 * \struct PearceFrame
+	 * \brief Quadro da pilha explícita do algoritmo de Pearce.
 	 */
-	class NullNodeVisitor : public NodeVisitor {
-	public:
-		/**
-		 * \brief Método chamado para visitar um nó.
-		 * \param node Ponteiro para o nó sendo visitado.
-		 *
-		 * Esta implementação não realiza nenhuma ação.
-		 */
-		void visit([[maybe_unused]] City* node) override {}
+	struct PearceFrame {
+		CityId node;
+		EdgeIndex next;
+		// Nenhuma aresta da subárvore alcançou um nó descoberto antes deste.
+		bool root;
 	};
 
 	/**
 	 * \brief Executa uma visita em profundidade (DFS) a partir de um nó.
 	 *
-	 * \param node O nó inicial para a DFS.
+	 * \param graph O grafo percorrido.
+	 * \param root O nó inicial para a DFS, raiz da árvore atual.
 	 * \param time Ponteiro para o contador de tempo.
-	 * \param coloring Mapa de cores para rastrear o estado dos nós.
-	 * \param start Mapa de tempos de descoberta dos nós.
-	 * \param finish Mapa de tempos de finalização dos nós.
-	 * \param nodeVisitor Objeto visitante a ser aplicado em cada nó visitado.
+	 * \param state Estado da DFS (cores, tempos de descoberta e finalização).
+	 * \param stack Pilha explícita de quadros, reaproveitada entre as árvores.
+	 * \param onVisit Função chamada com `(node, root, parent)` quando o nó é descoberto.
 	 *
 	 * Essa função realiza uma busca em profundidade (DFS) em um grafo, registrando
-	 * tempos de descoberta e finalização, enquanto utiliza o `NodeVisitor` fornecido
-	 * para executar ações específicas durante a travessia.
+	 * tempos de descoberta e finalização. A recursão é substituída por uma pilha de
+	 * quadros de 8 bytes, de modo que cadeias longas de cidades não estouram a pilha
+	 * da thread.
 	 *
-	 * \note Complexidade: O(V + E), onde V é o número de nós e E o número de arestas.
+	 * \note Complexidade: O(V + E) de tempo e O(V) de memória para a pilha.
 	 */
-	static void dfs_visit(City* node, std::size_t* time,
-		std::unordered_map<City*, CityColor, CityHash, CityEqual>* coloring,
-		std::unordered_map<City*, DiscoveryTime, CityHash, CityEqual>* start,
-		std::unordered_map<City*, FinishingTime, CityHash, CityEqual>* finish,
-		NodeVisitor* nodeVisitor) {
-		(*time)++;
-		(*start)[node] = *time;
-		(*coloring)[node] = CityColor::DISCOVERED;
-
-		nodeVisitor->visit(node);
-
-		for (Road& edge : node->getEdges())
-			if (City* target = edge.getTarget(); (*coloring)[target] == CityColor::UNDISCOVERED) {
-				nodeVisitor->dfs_recent_visit = node;
-				dfs_visit(target, time, coloring, start, finish, nodeVisitor);
+	template <typename OnVisit>
+	void dfs_visit(const Graph& graph, CityId root, std::uint32_t* time,
+		TraversalState& state, std::vector<DFSFrame>& stack, OnVisit& onVisit) {
+		auto discover = [&](CityId node, CityId parent) {
+			state.setDiscoveryTime(node, ++(*time));
+			state.setColor(node, CityColor::DISCOVERED);
+
+			onVisit(node, root, parent);
+
+			stack.push_back({ node, graph.begin(node) });
+		};
+
+		discover(root, NO_CITY);
+
+		while (!stack.empty()) {
+			DFSFrame& frame = stack.back();
+
+			if (frame.next < graph.end(frame.node)) {
+				CityId target = graph.target(frame.next++);
+				if (state.getColor(target) == CityColor::UNDISCOVERED)
+					discover(target, frame.node);
+				continue;
 			}
 
-		(*coloring)[node] = CityColor::FINISHED;
-		(*time)++;
-		(*finish)[node] = *time;
+			state.setColor(frame.node, CityColor::FINISHED);
+			state.setFinishingTime(frame.node, ++(*time));
+			state.appendFinished(frame.node);
+			stack.pop_back();
+		}
 	}
 
 	/**
-	 * \brief Ordena nós por seus tempos de finalização em ordem decrescente.
-	 *
-	 * \param nodes Vetor de nós a serem ordenados.
-	 * \param finishingTime Mapa contendo os tempos de finalização de cada nó.
-	 * \return Um vetor de nós ordenados por tempo de finalização em ordem decrescente.
-	 *
-	 * Essa função utiliza um algoritmo de ordenação Bubble Sort para reordenar os nós.
-	 *
-	 * \note Complexidade: O(n^2), onde n é o número de nós.
+	 * \brief Executa a DFS completa, iniciando uma nova árvore em cada nó ainda não descoberto de `order`.
 	 */
-	std::vector<City> sortNodesByFinishingTime(
-		std::vector<City>& nodes,
-		std::unordered_map<City*, FinishingTime, CityHash, CityEqual>& finishingTime) {
-		std::vector<City*> nodePointers;
-		for (auto& node : nodes) {
-			nodePointers.push_back(&node);
-		}
+	template <typename OnVisit>
+	void dfs(const Graph& graph, const std::vector<CityId>& order, TraversalState& state, OnVisit onVisit) {
+		state.reset(graph.size());
+		std::uint32_t time = 0;
 
-		std::size_t n = nodePointers.size();
-		for (std::size_t i = 0; i < n - 1; ++i) {
-			for (std::size_t j = 0; j < n - i - 1; ++j) {
-				if (finishingTime[nodePointers[j]] < finishingTime[nodePointers[j + 1]]) {
-					std::swap(nodePointers[j], nodePointers[j + 1]);
-				}
-			}
-		}
+		std::vector<DFSFrame> stack;
+		stack.reserve(graph.size());
 
-		std::vector<City> nodes2;
-		for (auto node : nodePointers) {
-			nodes2.push_back(*node);
-		}
+		for (CityId node : order)
+			if (state.getColor(node) == CityColor::UNDISCOVERED)
+				dfs_visit(graph, node, &time, state, stack, onVisit);
+	}
 
-		return nodes2;
+	/**
+	 * \brief Executa a DFS sobre um grafo notificando um `NodeVisitor`.
+	 *
+	 * \param graph O grafo percorrido.
+	 * \param nodes As cidades do grafo, indexadas pelo identificador usado em `graph`.
+	 * \param nodeVisitor O visitante notificado a cada nó descoberto.
+	 */
+	DFS_DATA dfs(const Graph& graph, std::vector<City>& nodes, NodeVisitor* nodeVisitor) {
+		std::vector<CityId> order(graph.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			order[i] = static_cast<CityId>(i);
+
+		DFS_DATA state;
+		dfs(graph, order, state, [&](CityId node, CityId root, CityId parent) {
+			nodeVisitor->dfs_main_visit = &nodes[root];
+			nodeVisitor->dfs_recent_visit = parent == NO_CITY ? nullptr : &nodes[parent];
+			nodeVisitor->visit(&nodes[node]);
+			});
+
+		return state;
 	}
 }
 
 DFS_DATA Algorithms::DFS(Archadian* Archadian, NodeVisitor* nodeVisitor) {
-	return Algorithms::DFS(Archadian->getNodes(), nodeVisitor);
+	return dfs(Archadian->getGraph(), Archadian->getNodes(), nodeVisitor);
 }
 
 DFS_DATA Algorithms::DFS(std::vector<City>& visitingNodes, NodeVisitor* nodeVisitor) {
-	std::unordered_map<City*, CityColor, CityHash, CityEqual> coloring;
-	std::unordered_map<City*, DiscoveryTime, CityHash, CityEqual> start;
-	std::unordered_map<City*, FinishingTime, CityHash, CityEqual> finish;
-
-	for (City& node : visitingNodes) {
-		coloring[&node] = CityColor::UNDISCOVERED;
-		start[&node] = 0;
-		finish[&node] = 0;
-	}
-
-	std::size_t time = 0;
-
-	for (City& node : visitingNodes)
-		if (coloring[&node] == CityColor::UNDISCOVERED) {
-			nodeVisitor->dfs_recent_visit = nullptr;
-			nodeVisitor->dfs_main_visit = &node;
-			dfs_visit(&node, &time, &coloring, &start, &finish, nodeVisitor);
-		}
+	return dfs(Graph::fromCities(visitingNodes), visitingNodes, nodeVisitor);
+}
 
-	return std::make_tuple(coloring, start, finish);;
+void Algorithms::DFS(const Graph& graph, const std::vector<CityId>& order, TraversalState& state) {
+	dfs(graph, order, state, []([[maybe_unused]] CityId node, [[maybe_unused]] CityId root, [[maybe_unused]] CityId parent) {});
 }
 
 void Algorithms::transposeArchadian(Archadian& Archadian) {
@@ -144,86 +143,192 @@ void Algorithms::transposeArchadian(Archadian& Archadian) {
 			node.connect(sourceNode);
 		}
 	}
-}
 
+	Archadian.setGraph(Archadian.getGraph().transpose());
+}
 
 std::vector<SCC> Algorithms::Kosaraju(Archadian* archadian) {
-	NullNodeVisitor nullNodeVisitor = NullNodeVisitor();
-	DFS_DATA data = Algorithms::DFS(archadian, &nullNodeVisitor);
-	auto& finishingTime = std::get<2>(data);
+	std::vector<CityId> order(archadian->getGraph().size());
+	for (std::size_t i = 0; i < order.size(); i++)
+		order[i] = static_cast<CityId>(i);
+
+	std::vector<SCC> sccs;
+	for (const auto& component : Algorithms::Kosaraju(archadian->getGraph(), order)) {
+		SCC scc;
+		for (CityId node : component)
+			scc.push_back(archadian->getNodes()[node]);
+		sccs.push_back(scc);
+	}
 
-	Algorithms::transposeArchadian(*archadian);
+	return sccs;
+}
 
-	std::vector<City> nodes2 = sortNodesByFinishingTime(archadian->getNodes(), finishingTime);
+std::vector<std::vector<CityId>> Algorithms::Kosaraju(const Graph& graph, const std::vector<CityId>& order) {
+	TraversalState state;
+	Algorithms::DFS(graph, order, state);
 
-	SCCNodeVisitor visitor = SCCNodeVisitor();
-	Algorithms::DFS(nodes2, &visitor);
-	visitor.finalize();
+	// A segunda passada começa pelas cidades de maior tempo de finalização: a pós-ordem invertida.
+	std::span<const CityId> postorder = state.getPostorder();
+	std::vector<CityId> nodes2(postorder.rbegin(), postorder.rend());
 
-	Algorithms::transposeArchadian(*archadian);
+	// A segunda passada reaproveita o mesmo estado da primeira.
+	std::vector<std::vector<CityId>> sccs;
+	dfs(graph.transpose(), nodes2, state, [&](CityId node, CityId root, [[maybe_unused]] CityId parent) {
+		if (node == root) sccs.emplace_back();
+		sccs.back().push_back(node);
+		});
 
-	return visitor.getSCCS();
+	return sccs;
 }
 
-std::unordered_map<City*, std::vector<City*>, CityHash, CityEqual> Algorithms::Dijkstra(Archadian* Archadian, City& source) {
-	std::unordered_map<City*, int, CityHash, CityEqual> distances;
-	std::unordered_map<City*, City*, CityHash, CityEqual> predecessors;
+Components Algorithms::Pearce(const Graph& graph, const std::vector<CityId>& order) {
+	const CityId n = static_cast<CityId>(graph.size());
 
-	for (City& node : Archadian->getNodes()) {
-		distances[&node] = std::numeric_limits<int>::max();
-		predecessors[&node] = nullptr;
-	}
-	distances[&source] = 0;
+	// rindex[v] == 0: não visitado; rindex[v] < c: ainda na DFS; caso contrário, componente finalizada.
+	std::vector<CityId> rindex(n, 0);
+	std::vector<CityId> stack;
+	std::vector<PearceFrame> frames;
+	frames.reserve(n);
 
-	using NodeDistPair = std::pair<int, City*>;
-	std::priority_queue<NodeDistPair, std::vector<NodeDistPair>, std::greater<NodeDistPair>> queue;
-	queue.push({ 0, &source });
+	// As componentes são finalizadas em ordem topológica reversa, e as cidades são
+	// gravadas do fim para o início de `members`.
+	std::vector<CityId> members(n);
+	std::vector<CityId> starts;
+	CityId end = n;
 
-	while (!queue.empty()) {
-		int distance = queue.top().first;
-		City* current = queue.top().second;
-		queue.pop();
+	CityId index = 1;
+	CityId c = n - 1;
 
-		int currentDistance = distances[current];
-		if (distance > currentDistance) continue;
+	auto finishEdge = [&](PearceFrame& frame, CityId w) {
+		if (rindex[w] < rindex[frame.node]) {
+			rindex[frame.node] = rindex[w];
+			frame.root = false;
+		}
+	};
+
+	for (CityId start : order) {
+		if (rindex[start] != 0) continue;
 
-		for (const Road& edge : current->getEdges()) {
-			City* neighbor = edge.getTarget();
-			int newDist = distances[current] + edge.getWeight();
+		rindex[start] = index++;
+		frames.push_back({ start, graph.begin(start), true });
 
-			if (newDist < distances[neighbor]) {
-				distances[neighbor] = newDist;
-				predecessors[neighbor] = current;
-				queue.push({ newDist, neighbor });
+		while (!frames.empty()) {
+			PearceFrame& frame = frames.back();
+
+			if (frame.next < graph.end(frame.node)) {
+				CityId w = graph.target(frame.next++);
+				if (rindex[w] == 0) {
+					rindex[w] = index++;
+					frames.push_back({ w, graph.begin(w), true });
+				}
+				else {
+					finishEdge(frame, w);
+				}
+				continue;
 			}
+
+			CityId v = frame.node;
+			bool root = frame.root;
+			frames.pop_back();
+
+			if (root) {
+				std::size_t first = stack.size();
+				while (first > 0 && rindex[v] <= rindex[stack[first - 1]])
+					first--;
+
+				CityId size = static_cast<CityId>(stack.size() - first) + 1;
+				end -= size;
+				starts.push_back(end);
+
+				members[end] = v;
+				for (std::size_t i = first; i < stack.size(); i++) {
+					members[end + 1 + (i - first)] = stack[i];
+					rindex[stack[i]] = c;
+				}
+
+				index -= size;
+				stack.resize(first);
+				rindex[v] = c;
+				c--;
+			}
+			else {
+				stack.push_back(v);
+			}
+
+			if (!frames.empty())
+				finishEdge(frames.back(), v);
 		}
 	}
 
-	std::unordered_map<City*, std::vector<City*>, CityHash, CityEqual> result;
-	for (const auto& pair : distances) {
-		City* node = pair.first;
+	// A componente finalizada por último é a primeira na ordem topológica.
+	const CityId count = static_cast<CityId>(starts.size());
+	std::vector<CityId> offsets(starts.rbegin(), starts.rend());
+	offsets.push_back(n);
 
-		if (*node == source) continue;
+	std::vector<ComponentId> component(n);
+	for (CityId node = 0; node < n; node++)
+		component[node] = rindex[node] - (n - count);
 
-		int distance = pair.second;
+	return Components(std::move(component), std::move(offsets), std::move(members));
+}
 
-		if (distance == std::numeric_limits<int>::max()) continue;
+ShortestPathTree Algorithms::Dijkstra(Archadian* Archadian, City& source) {
+	CityId sourceId = Archadian->getId(source);
+	if (sourceId == NO_CITY) return ShortestPathTree();
 
-		std::vector<City*> path;
-		for (City* at = node; at != nullptr; at = predecessors[at]) {
-			if (*at == source) continue;
-			path.push_back(at);
-		}
+	return Algorithms::Dijkstra(Archadian->getGraph(), sourceId);
+}
 
-		std::size_t n = path.size();
-		for (std::size_t i = 0; i < n / 2; ++i) {
-			City* temp = path[i];
-			path[i] = path[n - i - 1];
-			path[n - i - 1] = temp;
-		}
+ShortestPathTree Algorithms::Dijkstra(const Graph& graph, CityId source) {
+	SearchWorkspace workspace(graph.size());
+	Dijkstra(graph, source, workspace);
+	return ShortestPathTree(source, graph.size(), workspace);
+}
+
+void Algorithms::Dijkstra(const Graph& graph, CityId source, SearchWorkspace& workspace) {
+	workspace.start(graph.size());
+	workspace.reach(source, 0, NO_CITY);
+
+	// Com pesos pequenos a fila é um vetor de baldes (Dial); com pesos grandes, um heap 4-ário indexado.
+	BucketQueue& queue = workspace.queue(graph.maxWeight());
+	queue.push(source, 0);
+
+	while (!queue.empty()) {
+		Distance distance;
+		CityId current = queue.pop(distance);
+
+		if (distance > workspace.distance(current)) continue;
+		workspace.settle(current);
 
-		result[node] = path;
+		for (EdgeIndex edge = graph.begin(current); edge < graph.end(current); edge++) {
+			CityId neighbor = graph.target(edge);
+			Distance newDist = distance + graph.weight(edge);
+			Distance oldDist = workspace.distance(neighbor);
+
+			if (newDist < oldDist) {
+				workspace.reach(neighbor, newDist, current);
+				queue.push(neighbor, newDist);
+			}
+			// Entre caminhos de mesmo tamanho, o predecessor é o de menor (distância, identificador),
+			// independente da ordem em que a fila devolve as cidades de mesma distância.
+			else if (newDist == oldDist && neighbor != source) {
+				CityId parent = workspace.parent(neighbor);
+				if (std::pair(distance, current) < std::pair(workspace.distance(parent), parent))
+					workspace.setParent(neighbor, current);
+			}
+		}
 	}
+}
+
+bool Algorithms::ShortestPath(const Graph& graph, const Graph& reverse, CityId source, CityId target,
+	SearchWorkspace& forward, SearchWorkspace& backward, std::vector<CityId>& path) {
+	auto edges = [](const Graph& adjacency) {
+		return [&adjacency](CityId node, auto&& visit) {
+			for (EdgeIndex edge = adjacency.begin(node); edge < adjacency.end(node); edge++)
+				visit(adjacency.target(edge), adjacency.weight(edge));
+		};
+	};
 
-	return result;
-}
\ No newline at end of file
+	return BidirectionalSearch(source, target, graph.size(), graph.maxWeight(), forward, backward,
+		edges(graph), edges(reverse), path);
+}
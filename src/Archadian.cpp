@@ -1,119 +1,139 @@
 #include "Archadian.h"
 
+#include <algorithm>
 #include <cassert>
-#include <limits>
 
 #include "Algorithms.h"
+#include "CapitalFinder.h"
+#include "PatrolBuilder.h"
+#include "ThreadPool.h"
 
-Archadian::Archadian() : m_nodes(), m_capital() {}
+Archadian::Archadian() : m_nodes(), m_graph() {}
 
-Archadian::Archadian(const std::vector<City>& nodes) : m_nodes(nodes) {
+Archadian::Archadian(const std::vector<City>& nodes) : m_nodes(nodes), m_graph(Graph::fromCities(nodes)) {
+}
+
+Archadian::Archadian(std::vector<City> nodes, Graph graph, NameTable names)
+	: m_nodes(std::move(nodes)), m_graph(std::move(graph)), m_names(std::move(names)) {
+	assert(m_nodes.size() == m_graph.size());
 }
 
 std::vector<City>& Archadian::getNodes() {
 	return m_nodes;
 }
 
-City Archadian::getCapital() const { return m_capital; }
-
-Battalions Archadian::getBattalions() const { return m_battalions; }
+const std::vector<City>& Archadian::getNodes() const {
+	return m_nodes;
+}
 
-std::vector<Patrolling> Archadian::getPatrolling() const { return m_patrolling; }
+const Graph& Archadian::getGraph() const {
+	return m_graph;
+}
 
-bool Archadian::hasBattalions() const { return m_hasBattalions; }
+void Archadian::setGraph(Graph graph) {
+	assert(graph.size() == m_nodes.size());
+	m_graph = std::move(graph);
+	m_condensationStart = NO_CITY;
+}
 
-void Archadian::calcCapital() {
-	std::unordered_map<City*, std::size_t, CityHash, CityEqual> distances;
+CityId Archadian::getId(const City& city) const {
+	// As cidades lidas do mapa so indexadas a partir de 1, na ordem do vetor.
+	if (std::size_t position = city.getIndex() - 1; position < m_nodes.size() && m_nodes[position] == city)
+		return static_cast<CityId>(position);
 
-	for (City& node : m_nodes) {
-		auto dijkstra = Algorithms::Dijkstra(this, node);
+	for (std::size_t i = 0; i < m_nodes.size(); i++)
+		if (m_nodes[i] == city)
+			return static_cast<CityId>(i);
 
-		// Se no se existir caminho pra todos os ns do grafo esse n no  candidato a ser capitao.
-		if (dijkstra.size() != m_nodes.size() - 1) continue;
+	return NO_CITY;
+}
 
-		int sum = 0;
-		for (const auto& pair : dijkstra)
-			sum += static_cast<int>(pair.second.size());
-		distances[&node] = sum;
-	}
+const NameTable& Archadian::getNames() const { return m_names; }
 
-	std::size_t maior = std::numeric_limits< std::size_t>::max();
-	for (const auto& pair : distances)
-		if (pair.second < maior && pair.second > 0) {
-			maior = pair.second;
-			m_capital = *pair.first;
-		}
+std::string_view Archadian::getName(CityId node) const {
+	if (node == NO_CITY) return {};
+	return m_names.get(m_nodes[node].getNameId());
 }
 
-void Archadian::calcBattalionsAndPatrolling() {
-	Algorithms::moveToFirst<City>(m_nodes, m_capital);
+CityId Archadian::getCapital() const { return m_capitalId; }
 
-	auto sccs = Algorithms::Kosaraju(this);
+Battalions Archadian::getBattalions() const { return m_battalions; }
 
-	m_hasBattalions = !(sccs.size() == 1 && sccs[0][0] == m_capital);
+const Components& Archadian::getComponents() const { return m_condensation.components(); }
 
-	// Remove a scc formada so pelo capitao, se existir.
-	for (auto it = sccs.begin(); it != sccs.end();) {
-		if (it->size() == 1 && it->front().getIndex() == m_capital.getIndex()) {
-			it = sccs.erase(it);
-		}
-		else {
-			++it;
-		}
-	}
+const Condensation& Archadian::getCondensation() const { return m_condensation; }
 
-	for (auto scc : sccs)
-		// No existe batalhao comeando pela capital
-		if (auto battalion = scc[0]; scc[0] != m_capital)
-			m_battalions.push_back(scc[0]);
+CityId Archadian::getCondensationStart() const { return m_condensationStart; }
 
-	// No existe patrulha de um batalhao s.
-	for (auto it = sccs.begin(); it != sccs.end();) {
-		if (it->size() == 1) {
-			it = sccs.erase(it);
-		}
-		else {
-			++it;
-		}
-	}
+std::size_t Archadian::getPatrolCount() const { return m_patrolOffsets.size() - 1; }
+
+Patrolling Archadian::getPatrolling(std::size_t patrol) const {
+	return Patrolling(m_patrolCities.data() + m_patrolOffsets[patrol], m_patrolOffsets[patrol + 1] - m_patrolOffsets[patrol]);
+}
+
+std::span<const CityId> Archadian::getPatrolCities() const { return m_patrolCities; }
 
-	for (auto scc : sccs) {
-		SCC patrolling;
+std::span<const std::size_t> Archadian::getPatrolOffsets() const { return m_patrolOffsets; }
 
-		// Percorre o caminho da scc com o caminho original do grafo.
-		Archadian archadian2 = Archadian(scc);
-		{
-			Algorithms::transposeArchadian(archadian2);
+bool Archadian::hasBattalions() const { return m_hasBattalions; }
 
-			SCCNodeVisitor visitedNodeCollector = SCCNodeVisitor();
-			auto dfs_data = Algorithms::DFS(&archadian2, &visitedNodeCollector);
-			visitedNodeCollector.finalize();
+void Archadian::calcCapital(std::size_t threads) {
+	// A capital ainda no  conhecida; a DFS das componentes comea pela primeira cidade.
+	condense(0);
+	m_capitalId = CapitalFinder(m_graph).find(CapitalFinder::candidates(m_condensation), CapitalFinder::Strategy::BIT_PARALLEL, threads);
+}
 
-			auto sccs = visitedNodeCollector.getSCCS();
-			assert(sccs.size() == 1);
+void Archadian::condense(CityId start) {
+	if (m_condensationStart == start) return;
 
-			patrolling = sccs[0];
-		}
+	std::vector<CityId> order;
+	order.reserve(m_graph.size());
+	if (start < m_graph.size()) order.push_back(start);
+	for (CityId node = 0; node < m_graph.size(); node++)
+		if (node != start) order.push_back(node);
 
-		// Adiciona um caminho de volta pro batalhao apos visitar todas as cidades do patrulhamento.
-		{
-			City first = patrolling[0];
-			City last = patrolling[patrolling.size() - 1];
+	m_condensation = Condensation(m_graph, Algorithms::Pearce(m_graph, order));
+	m_condensationStart = start;
+}
 
-			if (first != last) {
-				auto dijkstra = Algorithms::Dijkstra(&archadian2, last);
-				auto pathPointer = dijkstra[&first];
+void Archadian::calcBattalionsAndPatrolling(std::size_t threads) {
+	// A DFS que encontra as componentes comea pela capital, para que ela seja a raiz da sua componente.
+	// Sem capital, ou com a capital na cidade 0, a condensao de `calcCapital` serve como est.
+	condense(m_capitalId != NO_CITY ? m_capitalId : 0);
+	const Components& components = m_condensation.components();
 
-				std::vector<City> path;
-				for (auto city : pathPointer) {
-					path.push_back(*city);
-				}
-				assert(!path.empty());
+	m_hasBattalions = !(components.count() == 1 && components.root(0) == m_capitalId);
 
-				patrolling.insert(patrolling.end(), path.begin(), path.end() - 1);
-			}
-		}
+	for (ComponentId component = 0; component < components.count(); component++)
+		// No existe batalhao comeando pela capital
+		if (components.root(component) != m_capitalId)
+			m_battalions.push_back(components.root(component));
 
-		m_patrolling.push_back(patrolling);
+	// No existe patrulha de um batalhao s.
+	std::vector<ComponentId> patrolled;
+	for (ComponentId component = 0; component < components.count(); component++)
+		if (components.size(component) > 1)
+			patrolled.push_back(component);
+
+	// As patrulhas andam sobre as estradas do grafo, restritas a cada componente; o grafo transposto
+	// s serve para a busca que parte da raiz no caminho de volta. Cada componente  uma tarefa
+	// independente, com um PatrolBuilder por thread.
+	Graph transposed = m_graph.transpose();
+	ThreadPool pool(threads);
+
+	std::vector<PatrolBuilder> builders;
+	builders.reserve(pool.size());
+	for (std::size_t worker = 0; worker < pool.size(); worker++)
+		builders.emplace_back(m_graph, transposed, components);
+
+	std::vector<std::vector<CityId>> patrols(patrolled.size());
+	pool.run(patrolled.size(), [&](std::size_t task, std::size_t worker) {
+		builders[worker].build(patrolled[task], patrols[task]);
+		});
+
+	// As rotas so concatenadas na ordem das componentes, independente da thread que as construiu.
+	for (const std::vector<CityId>& patrol : patrols) {
+		m_patrolCities.insert(m_patrolCities.end(), patrol.begin(), patrol.end());
+		m_patrolOffsets.push_back(m_patrolCities.size());
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,46 @@
+#include "BucketQueue.h"
+
+#include <cassert>
+
+BucketQueue::BucketQueue(Weight maxWeight, std::size_t size) : m_heap(maxWeight <= MAX_BUCKETS ? 0 : size) {
+	if (maxWeight <= MAX_BUCKETS) m_buckets.resize(std::size_t{ maxWeight } + 1);
+}
+
+void BucketQueue::push(CityId node, Distance distance) {
+	if (!usesBuckets()) {
+		m_heap.push(node, distance);
+		return;
+	}
+
+	m_size++;
+	assert(distance >= m_current && distance - m_current < m_buckets.size());
+	m_buckets[distance % m_buckets.size()].push_back(node);
+}
+
+CityId BucketQueue::pop(Distance& distance) {
+	assert(!empty());
+	if (!usesBuckets()) return m_heap.pop(distance);
+
+	m_size--;
+
+	// Todas as cidades estão a menos de um ciclo de baldes da distância atual.
+	while (m_buckets[m_current % m_buckets.size()].empty())
+		m_current++;
+
+	std::vector<CityId>& bucket = m_buckets[m_current % m_buckets.size()];
+	CityId node = bucket.back();
+	bucket.pop_back();
+
+	distance = m_current;
+	return node;
+}
+
+void BucketQueue::clear() {
+	// Uma busca que esvaziou a fila já deixou todos os baldes vazios.
+	if (m_size != 0)
+		for (std::vector<CityId>& bucket : m_buckets)
+			bucket.clear();
+	m_heap.clear();
+	m_current = 0;
+	m_size = 0;
+}
@@ -0,0 +1,254 @@
+#include "CapitalFinder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+
+#include "Algorithms.h"
+#include "ThreadPool.h"
+
+CapitalFinder::CapitalFinder(const Graph& graph)
+	: m_graph(graph), m_visited((graph.size() + 63) / 64, 0), m_queue(),
+	m_seen(), m_frontier(), m_next(), m_active(), m_touched(), m_workspace() {
+	m_queue.reserve(graph.size());
+}
+
+Distance CapitalFinder::distanceSum(CityId source, Distance bound) {
+	if (m_graph.isWeighted()) return weightedDistanceSum(source, bound);
+
+	m_queue.clear();
+	m_queue.push_back(source);
+	visit(source);
+
+	Distance sum = 0;
+	Distance depth = 0;
+	std::size_t head = 0;
+
+	// BFS por níveis: todas as cidades descobertas a partir do nível atual estão a `depth` estradas da origem.
+	while (head < m_queue.size() && sum < bound) {
+		std::size_t levelEnd = m_queue.size();
+		depth++;
+
+		for (; head < levelEnd; head++) {
+			CityId node = m_queue[head];
+			for (EdgeIndex e = m_graph.begin(node); e < m_graph.end(node); e++) {
+				CityId target = m_graph.target(e);
+				if (visited(target)) continue;
+
+				visit(target);
+				m_queue.push_back(target);
+				sum += depth;
+			}
+		}
+	}
+
+	// A fila contém todas as cidades visitadas, então limpar só as suas palavras custa O(alcançadas).
+	for (CityId node : m_queue)
+		m_visited[node >> 6] = 0;
+
+	if (sum >= bound || m_queue.size() != m_graph.size())
+		return REJECTED;
+
+	return sum;
+}
+
+Distance CapitalFinder::weightedDistanceSum(CityId source, Distance bound) {
+	m_workspace.start(m_graph.size());
+	m_workspace.reach(source, 0, NO_CITY);
+
+	BucketQueue& queue = m_workspace.queue(m_graph.maxWeight());
+	queue.push(source, 0);
+
+	Distance sum = 0;
+	std::size_t settled = 0;
+
+	// As cidades são fixadas em ordem crescente de distância, então a soma parcial só cresce.
+	while (!queue.empty() && sum < bound) {
+		Distance distance;
+		CityId node = queue.pop(distance);
+		if (distance > m_workspace.distance(node)) continue;
+
+		m_workspace.settle(node);
+		settled++;
+		sum += distance;
+
+		for (EdgeIndex e = m_graph.begin(node); e < m_graph.end(node); e++) {
+			CityId target = m_graph.target(e);
+			Distance next = distance + m_graph.weight(e);
+			if (next >= m_workspace.distance(target)) continue;
+
+			m_workspace.reach(target, next, node);
+			queue.push(target, next);
+		}
+	}
+
+	if (sum >= bound || settled != m_graph.size())
+		return REJECTED;
+
+	return sum;
+}
+
+void CapitalFinder::distanceSums(std::span<const CityId> sources, std::span<Distance> sums) {
+	assert(sources.size() <= BATCH_SIZE && sums.size() == sources.size());
+	assert(!m_graph.isWeighted());
+
+	const std::size_t n = m_graph.size();
+	// Os vetores dos lotes só são alocados por quem usa a estratégia.
+	if (m_seen.size() != n) {
+		m_seen.assign(n, 0);
+		m_frontier.assign(n, 0);
+		m_next.assign(n, 0);
+		m_active.reserve(n);
+		m_touched.reserve(n);
+	}
+
+	std::array<std::size_t, BATCH_SIZE> reached{};
+	std::fill(sums.begin(), sums.end(), 0);
+
+	m_active.clear();
+	for (std::size_t i = 0; i < sources.size(); i++) {
+		CityId source = sources[i];
+		std::uint64_t bit = std::uint64_t{ 1 } << i;
+		if (m_frontier[source] == 0) m_active.push_back(source);
+		m_seen[source] |= bit;
+		m_frontier[source] |= bit;
+	}
+
+	Distance depth = 0;
+	while (!m_active.empty()) {
+		depth++;
+
+		// Cada estrada propaga, de uma vez, todas as origens que chegaram à sua cidade de partida.
+		m_touched.clear();
+		for (CityId node : m_active) {
+			std::uint64_t frontier = m_frontier[node];
+			m_frontier[node] = 0;
+			for (EdgeIndex e = m_graph.begin(node); e < m_graph.end(node); e++) {
+				CityId target = m_graph.target(e);
+				if (m_next[target] == 0) m_touched.push_back(target);
+				m_next[target] |= frontier;
+			}
+		}
+
+		m_active.clear();
+		for (CityId node : m_touched) {
+			std::uint64_t discovered = m_next[node] & ~m_seen[node];
+			m_next[node] = 0;
+			if (discovered == 0) continue;
+
+			m_seen[node] |= discovered;
+			m_frontier[node] = discovered;
+			m_active.push_back(node);
+
+			for (; discovered != 0; discovered &= discovered - 1) {
+				int i = std::countr_zero(discovered);
+				sums[static_cast<std::size_t>(i)] += depth;
+				reached[static_cast<std::size_t>(i)]++;
+			}
+		}
+	}
+
+	std::fill(m_seen.begin(), m_seen.end(), 0);
+
+	for (std::size_t i = 0; i < sources.size(); i++)
+		if (reached[i] + 1 != n) sums[i] = REJECTED;
+}
+
+std::vector<CityId> CapitalFinder::candidates() const {
+	std::vector<CityId> order(m_graph.size());
+	for (std::size_t i = 0; i < order.size(); i++)
+		order[i] = static_cast<CityId>(i);
+
+	return candidates(Condensation(m_graph, Algorithms::Pearce(m_graph, order)));
+}
+
+std::vector<CityId> CapitalFinder::candidates(const Condensation& condensation) {
+	if (condensation.sourceCount() != 1)
+		return {};
+
+	// Em ordem topológica, a única fonte é a primeira componente.
+	auto members = condensation.components().members(0);
+	std::vector<CityId> candidates(members.begin(), members.end());
+	std::sort(candidates.begin(), candidates.end());
+	return candidates;
+}
+
+CityId CapitalFinder::find(Strategy strategy, std::size_t threads) {
+	return find(candidates(), strategy, threads);
+}
+
+CityId CapitalFinder::find(std::span<const CityId> candidates, Strategy strategy, std::size_t threads) {
+	struct Candidate {
+		Distance sum = REJECTED;
+		CityId city = NO_CITY;
+	};
+
+	const std::size_t n = candidates.size();
+	if (n == 0) return NO_CITY;
+
+	const std::size_t tasks = (n + BATCH_SIZE - 1) / BATCH_SIZE;
+
+	// Os níveis das BFSs simultâneas só são distâncias quando todas as estradas têm peso 1.
+	if (m_graph.isWeighted()) strategy = Strategy::PER_SOURCE;
+
+	ThreadPool pool(threads);
+
+	// Uma área de trabalho por thread; o trabalhador 0 usa a deste objeto.
+	std::vector<CapitalFinder> workspaces;
+	workspaces.reserve(pool.size() - 1);
+	for (std::size_t worker = 1; worker < pool.size(); worker++)
+		workspaces.emplace_back(m_graph);
+
+	// Melhor soma já encontrada por qualquer thread, usada para interromper buscas que já perderam.
+	std::atomic<Distance> best = REJECTED;
+	std::vector<Candidate> results(tasks);
+
+	pool.run(tasks, [&](std::size_t task, std::size_t worker) {
+		CapitalFinder& finder = worker == 0 ? *this : workspaces[worker - 1];
+
+		std::array<CityId, BATCH_SIZE> sources;
+		std::size_t first = task * BATCH_SIZE;
+		std::size_t count = std::min(BATCH_SIZE, n - first);
+		for (std::size_t i = 0; i < count; i++)
+			sources[i] = candidates[first + i];
+
+		// As origens da tarefa estão em ordem crescente, então o empate fica com a cidade anterior.
+		Candidate& candidate = results[task];
+		auto consider = [&](CityId city, Distance sum) {
+			if (sum != REJECTED && sum > 0 && sum < candidate.sum) {
+				candidate.sum = sum;
+				candidate.city = city;
+			}
+		};
+
+		if (strategy == Strategy::BIT_PARALLEL) {
+			std::array<Distance, BATCH_SIZE> sums;
+			finder.distanceSums(std::span(sources.data(), count), std::span(sums.data(), count));
+			for (std::size_t i = 0; i < count; i++)
+				consider(sources[i], sums[i]);
+		}
+		else {
+			for (std::size_t i = 0; i < count; i++) {
+				// Uma soma igual à melhor de outra tarefa ainda pode vencer o empate, mas uma igual
+				// à melhor desta tarefa não.
+				Distance global = best.load(std::memory_order_relaxed);
+				Distance bound = std::min(candidate.sum, global == REJECTED ? REJECTED : global + 1);
+				consider(sources[i], finder.distanceSum(sources[i], bound));
+			}
+		}
+
+		Distance current = best.load(std::memory_order_relaxed);
+		while (candidate.sum < current && !best.compare_exchange_weak(current, candidate.sum, std::memory_order_relaxed)) {}
+		});
+
+	// As tarefas estão em ordem crescente de cidade: a redução com `<` mantém o empate com a cidade
+	// anterior, exatamente como na busca sequencial.
+	Candidate capital;
+	for (const Candidate& candidate : results)
+		if (candidate.sum < capital.sum)
+			capital = candidate;
+
+	return capital.city;
+}
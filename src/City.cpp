@@ -2,10 +2,10 @@
 
 City::City() : m_index(0) {}
 
-City::City(std::size_t index, std::string name) : m_index(index), m_name(name) {}
+City::City(std::size_t index, NameId name) : m_index(index), m_name(name) {}
 
-void City::connect(City* node) {
-	m_edges.push_back(Road(this, node));
+void City::connect(City* node, int weight) {
+	m_edges.push_back(Road(this, node, weight));
 }
 
 bool City::isConnected(City* node) {
@@ -15,12 +15,16 @@ bool City::isConnected(City* node) {
 	return false;
 }
 
-std::string& City::getName() { return m_name; }
+NameId City::getNameId() const { return m_name; }
 
 std::vector<Road>& City::getEdges() {
 	return m_edges;
 }
 
+const std::vector<Road>& City::getEdges() const {
+	return m_edges;
+}
+
 void City::setEdges(std::vector<Road> edges) { m_edges = edges; }
 
 bool City::operator==(const City& other) const {
@@ -0,0 +1,16 @@
+#include "Components.h"
+
+#include <cassert>
+
+Components::Components() : m_component(), m_offsets(1, 0), m_members() {}
+
+Components::Components(std::vector<ComponentId> component, std::vector<CityId> offsets, std::vector<CityId> members)
+	: m_component(std::move(component)), m_offsets(std::move(offsets)), m_members(std::move(members)) {
+	assert(!m_offsets.empty() && m_offsets.back() == m_members.size());
+}
+
+std::size_t Components::count() const { return m_offsets.size() - 1; }
+
+std::span<const CityId> Components::members(ComponentId component) const {
+	return std::span<const CityId>(m_members.data() + m_offsets[component], size(component));
+}
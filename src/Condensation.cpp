@@ -0,0 +1,37 @@
+#include "Condensation.h"
+
+#include <algorithm>
+#include <cassert>
+
+Condensation::Condensation() : m_components(), m_offsets(1, 0), m_targets(), m_inDegree() {}
+
+Condensation::Condensation(const Graph& graph, Components components)
+	: m_components(std::move(components)), m_offsets(), m_targets(), m_inDegree(m_components.count(), 0) {
+	const std::size_t count = m_components.count();
+	m_offsets.reserve(count + 1);
+	m_offsets.push_back(0);
+
+	// Cada destino é marcado com a última componente que o viu, então as estradas paralelas entre
+	// duas componentes geram uma única aresta, sem apagar as marcas entre as componentes.
+	std::vector<ComponentId> seen(count, NO_COMPONENT);
+	for (ComponentId component = 0; component < count; component++) {
+		std::size_t begin = m_targets.size();
+
+		for (CityId node : m_components.members(component)) {
+			for (CityId target : graph.neighbors(node)) {
+				ComponentId other = m_components.componentOf(target);
+				if (other == component || seen[other] == component) continue;
+
+				assert(other > component);
+				seen[other] = component;
+				m_targets.push_back(other);
+				m_inDegree[other]++;
+			}
+		}
+
+		std::sort(m_targets.begin() + static_cast<std::ptrdiff_t>(begin), m_targets.end());
+		m_offsets.push_back(static_cast<EdgeIndex>(m_targets.size()));
+	}
+
+	m_sourceCount = static_cast<std::size_t>(std::count(m_inDegree.begin(), m_inDegree.end(), 0u));
+}
@@ -0,0 +1,444 @@
+#include "DynamicArchadian.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Algorithms.h"
+#include "CapitalFinder.h"
+#include "PatrolBuilder.h"
+
+DynamicArchadian::DynamicArchadian(const Archadian& archadian, std::size_t threads)
+	: m_maxWeight(archadian.getGraph().maxWeight()), m_names(archadian.getNames()), m_capital(archadian.getCapital()), m_threads(threads) {
+	const Graph& graph = archadian.getGraph();
+	CityId size = static_cast<CityId>(graph.size());
+
+	m_out.resize(size);
+	m_in.resize(size);
+	m_weights.resize(size);
+	m_inWeights.resize(size);
+	for (CityId node = 0; node < size; node++)
+		for (EdgeIndex edge = graph.begin(node); edge < graph.end(node); edge++) {
+			m_out[node].push_back(graph.target(edge));
+			m_in[graph.target(edge)].push_back(node);
+			m_weights[node].push_back(graph.weight(edge));
+			m_inWeights[graph.target(edge)].push_back(graph.weight(edge));
+			if (graph.weight(edge) != 1) m_weightedRoads++;
+		}
+
+	m_nameCity.assign(m_names.size(), NO_CITY);
+	m_cityName.reserve(size);
+	for (CityId node = 0; node < size; node++) {
+		NameId name = archadian.getNodes()[node].getNameId();
+		m_cityName.push_back(name);
+		if (name != NO_NAME) m_nameCity[name] = node;
+	}
+
+	// Uma capital ausente pode não ter sido calculada: ela é recalculada na primeira consulta.
+	m_capitalValid = m_capital != NO_CITY;
+
+	// As mesmas componentes e raízes de `Archadian::calcBattalionsAndPatrolling`: a DFS começa pela capital.
+	// A condensação do `Archadian` é reaproveitada se a sua DFS começou pela mesma cidade.
+	CityId start = m_capital != NO_CITY ? m_capital : 0;
+	Components computed;
+	if (archadian.getCondensationStart() != start && size > 0) {
+		std::vector<CityId> order;
+		order.reserve(size);
+		order.push_back(start);
+		for (CityId node = 0; node < size; node++)
+			if (node != start) order.push_back(node);
+
+		computed = Algorithms::Pearce(graph, order);
+	}
+	const Components& components = computed.count() > 0 ? computed : archadian.getComponents();
+
+	m_component.resize(size);
+	m_components.resize(components.count());
+	m_order.resize(components.count());
+	m_componentCount = components.count();
+	for (ComponentId component = 0; component < components.count(); component++) {
+		std::span<const CityId> members = components.members(component);
+		m_components[component].members.assign(members.begin(), members.end());
+		m_components[component].representative = components.root(component);
+		m_components[component].position = component;
+		m_order[component] = component;
+		for (CityId node : members)
+			m_component[node] = component;
+	}
+}
+
+std::string_view DynamicArchadian::getName(CityId city) const {
+	if (city == NO_CITY) return {};
+	return m_names.get(m_cityName[city]);
+}
+
+CityId DynamicArchadian::findCity(std::string_view name) {
+	NameId id = m_names.find(name);
+	return id == NO_NAME ? NO_CITY : m_nameCity[id];
+}
+
+CityId DynamicArchadian::addCity(std::string_view name) {
+	CityId city = static_cast<CityId>(size());
+
+	NameId id = m_names.add(name);
+	m_cityName.push_back(id);
+	m_nameCity.resize(m_names.size(), NO_CITY);
+	m_nameCity[id] = city;
+
+	m_out.emplace_back();
+	m_in.emplace_back();
+	m_weights.emplace_back();
+	m_inWeights.emplace_back();
+
+	// Uma cidade sem estradas pode ficar em qualquer posição da ordem: vai para o fim.
+	ComponentId component = allocate();
+	m_components[component].members.push_back(city);
+	m_components[component].representative = city;
+	m_components[component].position = m_order.size();
+	m_order.push_back(component);
+	m_component.push_back(component);
+
+	m_capitalValid = false;
+	return city;
+}
+
+void DynamicArchadian::addRoad(CityId source, CityId target, Weight weight) {
+	assert(weight > 0);
+	m_out[source].push_back(target);
+	m_in[target].push_back(source);
+	m_weights[source].push_back(weight);
+	m_inWeights[target].push_back(weight);
+	if (weight != 1) m_weightedRoads++;
+	m_maxWeight = std::max(m_maxWeight, weight);
+	m_capitalValid = false;
+
+	ComponentId from = m_component[source];
+	ComponentId to = m_component[target];
+	if (from == to) {
+		m_components[from].patrolValid = false;
+		return;
+	}
+
+	// A estrada respeita a ordem: nenhum ciclo novo e nada a reordenar.
+	std::size_t lower = m_components[to].position;
+	std::size_t upper = m_components[from].position;
+	if (upper < lower) return;
+
+	// Só as componentes entre `to` e `from` na ordem podem estar em um ciclo com a nova estrada
+	// ou precisar mudar de posição.
+	if (++m_search == 0) {
+		std::fill(m_forward.begin(), m_forward.end(), 0);
+		std::fill(m_backward.begin(), m_backward.end(), 0);
+		m_search = 1;
+	}
+	m_forward.resize(m_components.size(), 0);
+	m_backward.resize(m_components.size(), 0);
+
+	std::vector<ComponentId> after, before;
+	search(to, lower, upper, true, m_forward, after);
+	search(from, lower, upper, false, m_backward, before);
+
+	// Posições ocupadas pelas componentes visitadas, que são redistribuídas entre elas.
+	std::vector<std::size_t> positions;
+	positions.reserve(after.size() + before.size());
+	for (ComponentId component : before)
+		positions.push_back(m_components[component].position);
+	for (ComponentId component : after)
+		if (m_backward[component] != m_search)
+			positions.push_back(m_components[component].position);
+	std::sort(positions.begin(), positions.end());
+
+	// As componentes alcançáveis a partir de `to` que alcançam `from` formam um ciclo com a nova estrada.
+	ComponentId merged = NO_COMPONENT;
+	if (m_forward[from] == m_search) {
+		std::vector<ComponentId> cycle;
+		for (ComponentId component : after)
+			if (m_backward[component] == m_search)
+				cycle.push_back(component);
+
+		std::erase_if(after, [&](ComponentId component) { return m_backward[component] == m_search; });
+		std::erase_if(before, [&](ComponentId component) { return m_forward[component] == m_search; });
+		merged = merge(cycle);
+	}
+
+	auto byPosition = [&](ComponentId a, ComponentId b) { return m_components[a].position < m_components[b].position; };
+	std::sort(before.begin(), before.end(), byPosition);
+	std::sort(after.begin(), after.end(), byPosition);
+
+	// As que alcançam `from` ocupam as primeiras posições e as alcançáveis a partir de `to`, as
+	// últimas, sem mudar a ordem entre si; a componente unida fica entre elas. As posições que sobram
+	// ficam vazias.
+	for (std::size_t position : positions)
+		m_order[position] = NO_COMPONENT;
+
+	for (std::size_t i = 0; i < before.size(); i++) {
+		m_components[before[i]].position = positions[i];
+		m_order[positions[i]] = before[i];
+	}
+	if (merged != NO_COMPONENT) {
+		m_components[merged].position = positions[before.size()];
+		m_order[positions[before.size()]] = merged;
+	}
+	for (std::size_t i = 0; i < after.size(); i++) {
+		std::size_t position = positions[positions.size() - after.size() + i];
+		m_components[after[i]].position = position;
+		m_order[position] = after[i];
+	}
+
+	if (m_order.size() > 2 * m_componentCount) renumber(NO_COMPONENT, {});
+}
+
+bool DynamicArchadian::removeRoad(CityId source, CityId target) {
+	std::vector<CityId>& out = m_out[source];
+	auto road = std::find(out.begin(), out.end(), target);
+	if (road == out.end()) return false;
+
+	std::vector<Weight>& weights = m_weights[source];
+	auto weight = weights.begin() + (road - out.begin());
+	if (*weight != 1) m_weightedRoads--;
+	weights.erase(weight);
+	out.erase(road);
+
+	// As estradas paralelas saem das duas listas na ordem em que foram abertas, então a primeira
+	// ocorrência de `source` em `m_in` é a mesma estrada, com o mesmo peso.
+	std::vector<CityId>& in = m_in[target];
+	auto reverse = std::find(in.begin(), in.end(), source);
+	m_inWeights[target].erase(m_inWeights[target].begin() + (reverse - in.begin()));
+	in.erase(reverse);
+
+	m_capitalValid = false;
+
+	// Uma estrada entre componentes diferentes não faz parte de nenhum ciclo.
+	ComponentId component = m_component[source];
+	if (component != m_component[target]) return true;
+
+	m_components[component].patrolValid = false;
+	split(component);
+	return true;
+}
+
+std::vector<ComponentId> DynamicArchadian::getComponents() const {
+	std::vector<ComponentId> components;
+	components.reserve(m_componentCount);
+	for (ComponentId component : m_order)
+		if (component != NO_COMPONENT)
+			components.push_back(component);
+	return components;
+}
+
+CityId DynamicArchadian::getCapital() {
+	if (m_capitalValid) return m_capital;
+
+	std::vector<Edge> edges;
+	for (CityId node = 0; node < size(); node++)
+		for (std::size_t i = 0; i < m_out[node].size(); i++)
+			edges.push_back({ node, m_out[node][i], m_weights[node][i] });
+
+	// As componentes mantidas dispensam a condensação de `CapitalFinder::candidates`: a capital só pode
+	// estar na única componente que não recebe estradas de outras.
+	std::vector<bool> reached(m_components.size(), false);
+	for (CityId node = 0; node < size(); node++)
+		for (CityId target : m_out[node])
+			if (m_component[target] != m_component[node]) reached[m_component[target]] = true;
+
+	std::vector<CityId> candidates;
+	std::size_t sources = 0;
+	for (ComponentId component : m_order) {
+		if (component == NO_COMPONENT || reached[component]) continue;
+		sources++;
+		candidates = m_components[component].members;
+	}
+	if (sources != 1) candidates.clear();
+	std::sort(candidates.begin(), candidates.end());
+
+	Graph graph(size(), edges);
+	m_capital = CapitalFinder(graph).find(candidates, CapitalFinder::Strategy::BIT_PARALLEL, m_threads);
+	m_capitalValid = true;
+	return m_capital;
+}
+
+std::vector<CityId> DynamicArchadian::getBattalions() {
+	// A componente da capital não tem batalhão, mesmo que o seu representante seja outra cidade.
+	CityId capital = getCapital();
+	ComponentId home = capital != NO_CITY ? m_component[capital] : NO_COMPONENT;
+
+	std::vector<CityId> battalions;
+	for (ComponentId component : m_order)
+		if (component != NO_COMPONENT && component != home)
+			battalions.push_back(m_components[component].representative);
+	return battalions;
+}
+
+Patrolling DynamicArchadian::getPatrolling(ComponentId component) {
+	// A patrulha da componente da capital começa pela capital, que pode mudar sem que as estradas
+	// da componente mudem.
+	CityId capital = getCapital();
+	Component& state = m_components[component];
+	CityId start = capital != NO_CITY && m_component[capital] == component ? capital : state.representative;
+	if (state.patrolValid && state.patrolStart == start) return state.patrol;
+
+	state.patrol.clear();
+	state.patrolValid = true;
+	state.patrolStart = start;
+	if (state.members.size() < 2) return state.patrol;
+
+	// A patrulha é construída sobre o subgrafo da componente, com uma única componente cuja raiz é
+	// o início da patrulha. As cidades do subgrafo seguem a ordem dos identificadores, então os
+	// desempates do `PatrolBuilder` são os mesmos do grafo inteiro.
+	std::vector<CityId> members;
+	Graph graph = induced(component, members);
+	Graph transposed = graph.transpose();
+
+	CityId root = m_local[start];
+	std::vector<CityId> local(members.size());
+	local[0] = root;
+	for (CityId node = 0, i = 1; node < members.size(); node++)
+		if (node != root) local[i++] = node;
+
+	Components single(std::vector<ComponentId>(members.size(), 0), { 0, static_cast<CityId>(members.size()) }, std::move(local));
+
+	std::vector<CityId> patrol;
+	PatrolBuilder(graph, transposed, single).build(0, patrol);
+
+	state.patrol.reserve(patrol.size());
+	for (CityId node : patrol)
+		state.patrol.push_back(members[node]);
+	return state.patrol;
+}
+
+ComponentId DynamicArchadian::allocate() {
+	m_componentCount++;
+
+	if (!m_free.empty()) {
+		ComponentId component = m_free.back();
+		m_free.pop_back();
+		return component;
+	}
+
+	m_components.emplace_back();
+	return static_cast<ComponentId>(m_components.size() - 1);
+}
+
+void DynamicArchadian::search(ComponentId start, std::size_t lower, std::size_t upper, bool forward,
+	std::vector<std::uint32_t>& mark, std::vector<ComponentId>& found) {
+	mark[start] = m_search;
+	found.push_back(start);
+	m_stack.assign(1, start);
+
+	while (!m_stack.empty()) {
+		ComponentId component = m_stack.back();
+		m_stack.pop_back();
+
+		for (CityId node : m_components[component].members)
+			for (CityId neighbor : forward ? m_out[node] : m_in[node]) {
+				ComponentId next = m_component[neighbor];
+				std::size_t position = m_components[next].position;
+				if (mark[next] == m_search || position < lower || position > upper) continue;
+
+				mark[next] = m_search;
+				found.push_back(next);
+				m_stack.push_back(next);
+			}
+	}
+}
+
+ComponentId DynamicArchadian::merge(const std::vector<ComponentId>& components) {
+	// As cidades das componentes menores são movidas para a maior.
+	ComponentId host = *std::max_element(components.begin(), components.end(), [&](ComponentId a, ComponentId b) {
+		return m_components[a].members.size() < m_components[b].members.size();
+		});
+	ComponentId first = *std::min_element(components.begin(), components.end(), [&](ComponentId a, ComponentId b) {
+		return m_components[a].position < m_components[b].position;
+		});
+
+	Component& target = m_components[host];
+	target.representative = m_components[first].representative;
+	target.patrolValid = false;
+
+	for (ComponentId component : components) {
+		if (component == host) continue;
+
+		Component& source = m_components[component];
+		for (CityId node : source.members)
+			m_component[node] = host;
+		target.members.insert(target.members.end(), source.members.begin(), source.members.end());
+
+		source = Component();
+		m_free.push_back(component);
+		m_componentCount--;
+	}
+
+	return host;
+}
+
+void DynamicArchadian::split(ComponentId component) {
+	std::vector<CityId> members;
+	Graph graph = induced(component, members);
+
+	std::vector<CityId> order;
+	order.reserve(members.size());
+	CityId representative = m_local[m_components[component].representative];
+	order.push_back(representative);
+	for (CityId node = 0; node < members.size(); node++)
+		if (node != representative) order.push_back(node);
+
+	Components parts = Algorithms::Pearce(graph, order);
+	if (parts.count() == 1) return;
+
+	// A parte do representante mantém a componente; as outras recebem novas componentes, na
+	// ordem topológica calculada pelo Pearce.
+	std::vector<ComponentId> ids;
+	ids.reserve(parts.count());
+	for (ComponentId part = 0; part < parts.count(); part++) {
+		std::span<const CityId> local = parts.members(part);
+		bool keeps = parts.componentOf(representative) == part;
+		ComponentId id = keeps ? component : allocate();
+
+		Component& state = m_components[id];
+		state.members.clear();
+		for (CityId node : local) {
+			state.members.push_back(members[node]);
+			m_component[members[node]] = id;
+		}
+		if (!keeps) state.representative = members[*std::min_element(local.begin(), local.end())];
+		state.patrolValid = false;
+		ids.push_back(id);
+	}
+
+	renumber(component, ids);
+}
+
+void DynamicArchadian::renumber(ComponentId replaced, const std::vector<ComponentId>& parts) {
+	std::vector<ComponentId> order;
+	order.reserve(m_componentCount);
+
+	for (ComponentId component : m_order) {
+		if (component == NO_COMPONENT) continue;
+		if (component == replaced)
+			order.insert(order.end(), parts.begin(), parts.end());
+		else
+			order.push_back(component);
+	}
+
+	for (std::size_t position = 0; position < order.size(); position++)
+		m_components[order[position]].position = position;
+	m_order = std::move(order);
+}
+
+Graph DynamicArchadian::induced(ComponentId component, std::vector<CityId>& members) {
+	members = m_components[component].members;
+	std::sort(members.begin(), members.end());
+
+	m_local.resize(size());
+	for (CityId node = 0; node < members.size(); node++)
+		m_local[members[node]] = node;
+
+	std::vector<Edge> edges;
+	for (CityId node = 0; node < members.size(); node++)
+		for (std::size_t i = 0; i < m_out[members[node]].size(); i++) {
+			CityId target = m_out[members[node]][i];
+			Weight weight = m_weights[members[node]][i];
+			if (m_component[target] == component) edges.push_back({ node, m_local[target], weight });
+		}
+
+	return Graph(members.size(), edges);
+}
@@ -0,0 +1,74 @@
+#include "Graph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+#include "City.h"
+
+Graph::Graph() : m_offsets(1, 0), m_targets(), m_weights() {}
+
+Graph::Graph(std::size_t nodeCount, const std::vector<Edge>& edges)
+	: m_offsets(nodeCount + 1, 0), m_targets(edges.size()), m_weights() {
+	assert(edges.size() < std::numeric_limits<EdgeIndex>::max());
+
+	bool weighted = false;
+	for (const Edge& edge : edges) {
+		assert(edge.source < nodeCount && edge.target < nodeCount);
+		m_offsets[edge.source + 1]++;
+		weighted = weighted || edge.weight != 1;
+		m_maxWeight = std::max(m_maxWeight, edge.weight);
+	}
+
+	for (std::size_t i = 0; i < nodeCount; i++)
+		m_offsets[i + 1] += m_offsets[i];
+
+	if (weighted) m_weights.resize(edges.size());
+
+	// Ordenação por contagem estável: preserva a ordem das estradas de cada origem.
+	std::vector<EdgeIndex> next(m_offsets.begin(), m_offsets.end() - 1);
+	for (const Edge& edge : edges) {
+		EdgeIndex position = next[edge.source]++;
+		m_targets[position] = edge.target;
+		if (weighted) m_weights[position] = edge.weight;
+	}
+}
+
+Graph Graph::fromCities(const std::vector<City>& cities) {
+	std::unordered_map<std::size_t, CityId> ids;
+	for (std::size_t i = 0; i < cities.size(); i++)
+		ids[cities[i].getIndex()] = static_cast<CityId>(i);
+
+	std::vector<Edge> edges;
+	for (std::size_t i = 0; i < cities.size(); i++) {
+		for (const Road& road : cities[i].getEdges()) {
+			auto it = ids.find(road.getTarget()->getIndex());
+			if (it == ids.end()) continue;
+
+			edges.push_back({ static_cast<CityId>(i), it->second, static_cast<Weight>(road.getWeight()) });
+		}
+	}
+
+	return Graph(cities.size(), edges);
+}
+
+std::size_t Graph::size() const { return m_offsets.size() - 1; }
+
+std::size_t Graph::edgeCount() const { return m_targets.size(); }
+
+std::span<const CityId> Graph::neighbors(CityId node) const {
+	return std::span<const CityId>(m_targets.data() + m_offsets[node], m_offsets[node + 1] - m_offsets[node]);
+}
+
+bool Graph::isWeighted() const { return !m_weights.empty(); }
+
+Graph Graph::transpose() const {
+	std::vector<Edge> edges;
+	edges.reserve(m_targets.size());
+
+	for (CityId node = 0; node < size(); node++)
+		for (EdgeIndex edge = begin(node); edge < end(node); edge++)
+			edges.push_back({ target(edge), node, weight(edge) });
+
+	return Graph(size(), edges);
+}
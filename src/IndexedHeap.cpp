@@ -0,0 +1,86 @@
+#include "IndexedHeap.h"
+
+#include <cassert>
+
+IndexedHeap::IndexedHeap(std::size_t size) : m_heap(), m_position(size, ABSENT) {}
+
+bool IndexedHeap::push(CityId node, Distance distance) {
+	if (node >= m_position.size()) m_position.resize(std::size_t{ node } + 1, ABSENT);
+
+	std::uint32_t index = m_position[node];
+	if (index == ABSENT) {
+		index = static_cast<std::uint32_t>(m_heap.size());
+		m_heap.push_back({ distance, node });
+		m_position[node] = index;
+	}
+	else if (distance < m_heap[index].distance) {
+		m_heap[index].distance = distance;
+	}
+	else {
+		return false;
+	}
+
+	siftUp(index);
+	return true;
+}
+
+CityId IndexedHeap::pop(Distance& distance) {
+	assert(!empty());
+	Entry top = m_heap.front();
+	m_position[top.node] = ABSENT;
+
+	Entry last = m_heap.back();
+	m_heap.pop_back();
+	if (!m_heap.empty()) {
+		place(0, last);
+		siftDown(0);
+	}
+
+	distance = top.distance;
+	return top.node;
+}
+
+void IndexedHeap::clear() {
+	for (const Entry& entry : m_heap)
+		m_position[entry.node] = ABSENT;
+	m_heap.clear();
+}
+
+void IndexedHeap::siftUp(std::size_t index) {
+	// A entrada só é escrita no destino final; os pais maiores descem uma posição cada.
+	Entry entry = m_heap[index];
+	while (index > 0) {
+		std::size_t parent = (index - 1) / ARITY;
+		if (!(entry < m_heap[parent])) break;
+
+		place(index, m_heap[parent]);
+		index = parent;
+	}
+	place(index, entry);
+}
+
+void IndexedHeap::siftDown(std::size_t index) {
+	Entry entry = m_heap[index];
+	const std::size_t size = m_heap.size();
+
+	while (true) {
+		std::size_t first = ARITY * index + 1;
+		if (first >= size) break;
+
+		std::size_t smallest = first;
+		std::size_t last = first + ARITY < size ? first + ARITY : size;
+		for (std::size_t child = first + 1; child < last; child++)
+			if (m_heap[child] < m_heap[smallest]) smallest = child;
+
+		if (!(m_heap[smallest] < entry)) break;
+
+		place(index, m_heap[smallest]);
+		index = smallest;
+	}
+	place(index, entry);
+}
+
+void IndexedHeap::place(std::size_t index, const Entry& entry) {
+	m_heap[index] = entry;
+	m_position[entry.node] = static_cast<std::uint32_t>(index);
+}
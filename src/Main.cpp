@@ -1,82 +1,197 @@
 #include <iostream>
 
 #include <cassert>
-#include <unordered_set>
 #include <string>
-#include <limits>
+#include <cstring>
 
-#include "Algorithms.h"
-
-int main() {
-	std::size_t v, e;
-	std::cin >> v >> e;
-	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-	std::size_t index = 1;
-	std::unordered_map<std::string, City> map;
-	std::vector<std::string> insertion_order;
-
-	for (std::size_t i = 0; i < e; i++) {
-		std::string s1, s2;
+#include <fcntl.h>
+#include <unistd.h>
 
-		std::cin >> s1 >> s2;
-
-		City* c1 = nullptr;
-		if (auto it = map.find(s1); it == map.end()) {
-			map.insert({ s1, City(index++, s1) });
-			c1 = &map[s1];
-			insertion_order.push_back(s1);
+#include "Algorithms.h"
+#include "DynamicArchadian.h"
+#include "MapReader.h"
+#include "QueryServer.h"
+#include "Snapshot.h"
+
+namespace {
+	/**
+	 * Escreve a capital, os batalhões e as patrulhas de um `Archadian` ou de um `Snapshot`.
+	 */
+	template <typename Map>
+	void printResult(const Map& map) {
+		std::cout << map.getName(map.getCapital()) << '\n';
+
+		// Batalhao
+		if (!map.hasBattalions()) {
+			std::cout << "0" << '\n';
 		}
 		else {
-			c1 = &it->second;
+			Battalions battalions = map.getBattalions();
+			std::cout << battalions.size() << '\n';
+			for (CityId city : battalions) {
+				std::cout << map.getName(city) << '\n';
+			}
 		}
 
-		City* c2 = nullptr;
-		if (auto it2 = map.find(s2); it2 == map.end()) {
-			map.insert({ s2, City(index++, s2) });
-			c2 = &map[s2];
-			insertion_order.push_back(s2);
+		// Patrulhamento
+		std::cout << map.getPatrolCount() << '\n';
+		for (std::size_t patrol = 0; patrol < map.getPatrolCount(); patrol++) {
+			for (CityId city : map.getPatrolling(patrol))
+				std::cout << map.getName(city) << " ";
+			std::cout << '\n';
 		}
-		else {
-			c2 = &it2->second;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	// -t N / --threads N: número de threads da busca pela capital e das patrulhas (0 usa todos os processadores).
+	// -u / --updates: depois das estradas, a entrada traz aberturas ("+ A B", com um peso opcional)
+	// e fechamentos ("- A B") de estradas, aplicados incrementalmente antes da saída.
+	// --save ARQUIVO: escreve o mapa processado em um `Snapshot` binário.
+	// --snapshot ARQUIVO: mapeia um `Snapshot` e escreve o resultado sem ler nem processar o mapa.
+	// -s / --serve: carrega o mapa do arquivo e responde consultas da entrada padrão (`QueryServer`).
+	// --socket CAMINHO: como --serve, mas as consultas chegam por um socket Unix.
+	// Um argumento livre é o arquivo do mapa; sem ele, o mapa é lido da entrada padrão.
+	std::size_t threads = 1;
+	bool updates = false;
+	bool serve = false;
+	const char* socketPath = nullptr;
+	const char* savePath = nullptr;
+	const char* snapshotPath = nullptr;
+	const char* path = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if ((std::strcmp(argv[i], "-t") == 0 || std::strcmp(argv[i], "--threads") == 0) && i + 1 < argc)
+			threads = std::stoul(argv[++i]);
+		else if (std::strcmp(argv[i], "-u") == 0 || std::strcmp(argv[i], "--updates") == 0)
+			updates = true;
+		else if (std::strcmp(argv[i], "-s") == 0 || std::strcmp(argv[i], "--serve") == 0)
+			serve = true;
+		else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+			socketPath = argv[++i];
+		else if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+			savePath = argv[++i];
+		else if (std::strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc)
+			snapshotPath = argv[++i];
+		else
+			path = argv[i];
+	}
+
+	if (snapshotPath) {
+		Snapshot snapshot(snapshotPath);
+		if (!snapshot.isValid()) {
+			std::cerr << "Snapshot invalido: " << snapshotPath << std::endl;
+			return 1;
 		}
 
-		c1->connect(c2);
+		printResult(snapshot);
+		return 0;
 	}
 
-	assert(map.size() == v);
+	// No modo servidor a entrada padrão traz as consultas, então o mapa vem de um arquivo.
+	if (serve && !socketPath && !path) {
+		std::cerr << "O modo servidor precisa do arquivo do mapa" << std::endl;
+		return 1;
+	}
 
-	std::vector<City> cities;
-	for (const auto& name : insertion_order) {
-		cities.push_back(map[name]);
+	int fd = path ? open(path, O_RDONLY) : STDIN_FILENO;
+	if (fd < 0) {
+		std::cerr << "Nao foi possivel abrir " << path << std::endl;
+		return 1;
 	}
 
-	Archadian archadian = Archadian(cities);
+	MapReader reader(fd);
+	[[maybe_unused]] bool complete = reader.parse();
+	assert(complete);
+	assert(reader.names().size() == reader.cityCount());
 
-	archadian.calcCapital();
-	archadian.calcBattalionsAndPatrolling();
+	// Os nomes são copiados uma única vez para a tabela; cada cidade guarda só o identificador.
+	std::size_t bytes = 0;
+	for (std::string_view name : reader.names())
+		bytes += name.size();
+
+	NameTable names;
+	names.reserve(reader.names().size(), bytes);
+
+	std::vector<City> cities;
+	cities.reserve(reader.names().size());
+	for (std::size_t i = 0; i < reader.names().size(); i++)
+		cities.push_back(City(i + 1, names.add(reader.names()[i])));
 
-	auto capital = archadian.getCapital();
-	std::cout << capital.getName() << std::endl;
+	Graph graph = Graph(cities.size(), reader.edges());
+	Archadian archadian = Archadian(std::move(cities), std::move(graph), std::move(names));
 
-	// Batalhao
-	if (!archadian.hasBattalions()) {
-		std::cout << "0" << std::endl;
+	archadian.calcCapital(threads);
+
+	if (serve || socketPath) {
+		if (path) close(fd);
+
+		DynamicArchadian dynamic(archadian, threads);
+		QueryServer server(dynamic);
+		if (!socketPath) {
+			server.serve(STDIN_FILENO, STDOUT_FILENO);
+		}
+		else if (!server.listen(socketPath)) {
+			std::cerr << "Nao foi possivel escutar em " << socketPath << std::endl;
+			return 1;
+		}
+		return 0;
 	}
-	else {
-		auto battalions = archadian.getBattalions();
-		std::cout << battalions.size() << std::endl;
-		for (auto city : battalions) {
-			std::cout << city.getName() << std::endl;
+
+	if (updates) {
+		DynamicArchadian dynamic(archadian, threads);
+
+		for (std::string_view op = reader.next(); !op.empty(); op = reader.next()) {
+			std::string_view source = reader.next();
+			std::string_view target = reader.next();
+			std::string_view column = reader.nextOnLine();
+			if (target.empty()) break;
+
+			Weight weight = 1;
+			if (!column.empty() && !MapReader::parseWeight(column, weight)) continue;
+
+			CityId from = dynamic.findCity(source);
+			CityId to = dynamic.findCity(target);
+			if (op == "+") {
+				if (from == NO_CITY) from = dynamic.addCity(source);
+				if (to == NO_CITY) to = dynamic.addCity(target);
+				dynamic.addRoad(from, to, weight);
+			}
+			else if (op == "-" && from != NO_CITY && to != NO_CITY) {
+				dynamic.removeRoad(from, to);
+			}
+		}
+
+		if (path) close(fd);
+
+		std::cout << dynamic.getName(dynamic.getCapital()) << '\n';
+
+		std::vector<CityId> battalions = dynamic.getBattalions();
+		std::cout << battalions.size() << '\n';
+		for (CityId city : battalions)
+			std::cout << dynamic.getName(city) << '\n';
+
+		std::vector<ComponentId> patrolled;
+		for (ComponentId component : dynamic.getComponents())
+			if (dynamic.getMembers(component).size() > 1)
+				patrolled.push_back(component);
+
+		std::cout << patrolled.size() << '\n';
+		for (ComponentId component : patrolled) {
+			for (CityId city : dynamic.getPatrolling(component))
+				std::cout << dynamic.getName(city) << " ";
+			std::cout << '\n';
 		}
+		return 0;
 	}
 
-	// Patrulhamento
-	auto patrollings = archadian.getPatrolling();
-	std::cout << patrollings.size() << std::endl;
-	for (auto patrolling : patrollings) {
-		for (auto city : patrolling)
-			std::cout << city.getName() << " ";
-		std::cout << std::endl;
+	if (path) close(fd);
+
+	archadian.calcBattalionsAndPatrolling(threads);
+
+	if (savePath && !Snapshot::write(archadian, savePath)) {
+		std::cerr << "Nao foi possivel escrever " << savePath << std::endl;
+		return 1;
 	}
+
+	printResult(archadian);
 }
\ No newline at end of file
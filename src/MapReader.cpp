@@ -0,0 +1,142 @@
+#include "MapReader.h"
+
+#include <cerrno>
+#include <charconv>
+#include <functional>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+	/**
+	 * \brief Tamanho de cada bloco lido quando a entrada não pode ser mapeada.
+	 */
+	constexpr std::size_t READ_BLOCK = 1 << 20;
+
+	bool isSpace(char c) {
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+	}
+
+	std::size_t parseCount(std::string_view token) {
+		std::size_t value = 0;
+		std::from_chars(token.data(), token.data() + token.size(), value);
+		return value;
+	}
+}
+
+MapReader::MapReader(int fd) {
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+		void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			madvise(data, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+			m_data = static_cast<const char*>(data);
+			m_size = static_cast<std::size_t>(info.st_size);
+			m_mapped = true;
+			return;
+		}
+	}
+
+	// Pipes e terminais não podem ser mapeados: a entrada é lida inteira em blocos grandes.
+	std::size_t size = 0;
+	while (true) {
+		m_buffer.resize(size + READ_BLOCK);
+		ssize_t count = read(fd, m_buffer.data() + size, READ_BLOCK);
+		if (count < 0 && errno == EINTR) continue;
+		if (count <= 0) break;
+		size += static_cast<std::size_t>(count);
+	}
+
+	m_buffer.resize(size);
+	m_data = m_buffer.data();
+	m_size = size;
+}
+
+MapReader::~MapReader() {
+	if (m_mapped) munmap(const_cast<char*>(m_data), m_size);
+}
+
+bool MapReader::parse() {
+	m_position = 0;
+	m_cityCount = parseCount(next());
+	std::size_t roadCount = parseCount(next());
+
+	m_names.clear();
+	m_names.reserve(m_cityCount);
+	m_edges.clear();
+	m_edges.reserve(roadCount);
+
+	// A tabela fica no máximo metade cheia com o número de cidades declarado.
+	std::size_t slots = 16;
+	while (slots < 2 * m_cityCount) slots *= 2;
+	m_slots.assign(slots, NO_CITY);
+
+	for (std::size_t i = 0; i < roadCount; i++) {
+		std::string_view source = next();
+		std::string_view target = next();
+		if (target.empty()) return false;
+
+		Weight weight = 1;
+		std::string_view column = nextOnLine();
+		if (!column.empty() && !parseWeight(column, weight)) return false;
+
+		CityId c1 = intern(source);
+		CityId c2 = intern(target);
+		m_edges.push_back({ c1, c2, weight });
+	}
+
+	return true;
+}
+
+std::string_view MapReader::next() {
+	while (m_position < m_size && isSpace(m_data[m_position])) m_position++;
+
+	std::size_t start = m_position;
+	while (m_position < m_size && !isSpace(m_data[m_position])) m_position++;
+
+	return std::string_view(m_data + start, m_position - start);
+}
+
+std::string_view MapReader::nextOnLine() {
+	while (m_position < m_size && isSpace(m_data[m_position]) && m_data[m_position] != '\n') m_position++;
+	if (m_position < m_size && m_data[m_position] == '\n') return {};
+
+	return next();
+}
+
+bool MapReader::parseWeight(std::string_view token, Weight& weight) {
+	// Pesos nulos são recusados: um caminho de peso 0 não teria um predecessor bem definido.
+	auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), weight);
+	return error == std::errc() && end == token.data() + token.size() && weight > 0;
+}
+
+CityId MapReader::intern(std::string_view name) {
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t slot = std::hash<std::string_view>{}(name) & mask;
+
+	while (m_slots[slot] != NO_CITY) {
+		if (m_names[m_slots[slot]] == name) return m_slots[slot];
+		slot = (slot + 1) & mask;
+	}
+
+	CityId id = static_cast<CityId>(m_names.size());
+	m_names.push_back(name);
+	m_slots[slot] = id;
+
+	// Mais cidades do que o declarado: mantém a tabela no máximo metade cheia.
+	if (2 * m_names.size() > m_slots.size()) grow();
+
+	return id;
+}
+
+void MapReader::grow() {
+	m_slots.assign(2 * m_slots.size(), NO_CITY);
+	std::size_t mask = m_slots.size() - 1;
+
+	for (CityId id = 0; id < m_names.size(); id++) {
+		std::size_t slot = std::hash<std::string_view>{}(m_names[id]) & mask;
+		while (m_slots[slot] != NO_CITY) slot = (slot + 1) & mask;
+		m_slots[slot] = id;
+	}
+}
@@ -0,0 +1,62 @@
+#include "NameTable.h"
+
+#include <cassert>
+#include <functional>
+
+NameTable::NameTable() : m_bytes(), m_offsets(1, 0) {}
+
+void NameTable::reserve(std::size_t names, std::size_t bytes) {
+	m_offsets.reserve(names + 1);
+	m_bytes.reserve(bytes);
+}
+
+NameId NameTable::add(std::string_view name) {
+	assert(m_bytes.size() + name.size() <= std::numeric_limits<std::uint32_t>::max());
+
+	m_bytes.insert(m_bytes.end(), name.begin(), name.end());
+	m_offsets.push_back(static_cast<std::uint32_t>(m_bytes.size()));
+
+	NameId id = static_cast<NameId>(size() - 1);
+	if (!m_slots.empty()) index(id);
+
+	return id;
+}
+
+std::string_view NameTable::get(NameId id) const {
+	if (id == NO_NAME) return {};
+	return std::string_view(m_bytes.data() + m_offsets[id], m_offsets[id + 1] - m_offsets[id]);
+}
+
+NameId NameTable::find(std::string_view name) {
+	if (m_slots.empty()) {
+		std::size_t slots = 16;
+		while (slots < 2 * size()) slots *= 2;
+		m_slots.assign(slots, NO_NAME);
+		for (NameId id = 0; id < size(); id++)
+			index(id);
+	}
+
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t slot = std::hash<std::string_view>{}(name) & mask;
+
+	while (m_slots[slot] != NO_NAME) {
+		if (get(m_slots[slot]) == name) return m_slots[slot];
+		slot = (slot + 1) & mask;
+	}
+
+	return NO_NAME;
+}
+
+void NameTable::index(NameId id) {
+	if (2 * (id + 1) > m_slots.size()) {
+		// Dobra o índice e reinsere os nomes anteriores.
+		m_slots.assign(2 * m_slots.size(), NO_NAME);
+		for (NameId previous = 0; previous < id; previous++)
+			index(previous);
+	}
+
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t slot = std::hash<std::string_view>{}(get(id)) & mask;
+	while (m_slots[slot] != NO_NAME) slot = (slot + 1) & mask;
+	m_slots[slot] = id;
+}
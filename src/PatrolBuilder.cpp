@@ -0,0 +1,211 @@
+#include "PatrolBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+
+PatrolBuilder::PatrolBuilder(const Graph& graph, const Graph& transposed, const Components& components)
+	: m_graph(graph), m_reverse(transposed), m_components(components),
+	m_mark(transposed.size(), 0), m_parent(transposed.size(), NO_CITY), m_depth(transposed.size(), 0),
+	m_rank(transposed.size(), 0), m_workspace(transposed.size()), m_stack(), m_level(), m_rootLevel(), m_nextLevel() {}
+
+void PatrolBuilder::nextSearch() {
+	if (++m_search == 0) {
+		std::fill(m_mark.begin(), m_mark.end(), 0);
+		m_search = 1;
+	}
+}
+
+void PatrolBuilder::build(ComponentId component, std::vector<CityId>& patrol) {
+	const CityId root = m_components.root(component);
+	const std::size_t start = patrol.size();
+
+	nextSearch();
+
+	CityId previous = NO_CITY;
+	auto discover = [&](CityId node, CityId parent) {
+		m_mark[node] = m_search;
+
+		// A DFS voltou até `parent` antes de descobrir `node`.
+		if (previous != NO_CITY && parent != NO_CITY && previous != parent)
+			patrol.push_back(parent);
+		patrol.push_back(node);
+		previous = node;
+
+		m_stack.push_back({ node, m_graph.begin(node) });
+	};
+
+	discover(root, NO_CITY);
+
+	while (!m_stack.empty()) {
+		Frame& frame = m_stack.back();
+
+		if (frame.next < m_graph.end(frame.node)) {
+			CityId target = m_graph.target(frame.next++);
+			if (m_components.componentOf(target) == component && m_mark[target] != m_search)
+				discover(target, frame.node);
+			continue;
+		}
+
+		m_stack.pop_back();
+	}
+
+	CityId last = patrol.back();
+	if (last != patrol[start]) appendReturn(component, last, patrol);
+}
+
+void PatrolBuilder::rankMembers(ComponentId component) {
+	nextSearch();
+
+	std::uint32_t rank = 0;
+	auto discover = [&](CityId node) {
+		m_mark[node] = m_search;
+		m_rank[node] = rank++;
+		m_stack.push_back({ node, m_reverse.begin(node) });
+	};
+
+	// A mesma DFS da segunda passada do Kosaraju, restrita à componente: as cidades ficam na ordem
+	// em que o Kosaraju as listava.
+	discover(m_components.root(component));
+	while (!m_stack.empty()) {
+		Frame& frame = m_stack.back();
+
+		if (frame.next < m_reverse.end(frame.node)) {
+			CityId source = m_reverse.target(frame.next++);
+			if (m_components.componentOf(source) == component && m_mark[source] != m_search)
+				discover(source);
+			continue;
+		}
+
+		m_stack.pop_back();
+	}
+}
+
+void PatrolBuilder::appendReturn(ComponentId component, CityId from, std::vector<CityId>& patrol) {
+	const CityId root = m_components.root(component);
+
+	rankMembers(component);
+	if (m_graph.isWeighted()) weightedReturn(component, from);
+	else bidirectionalReturn(component, from);
+
+	// O caminho é reconstruído da raiz para trás e invertido no lugar.
+	auto parent = [this](CityId node) { return m_graph.isWeighted() ? m_workspace.parent(node) : m_parent[node]; };
+	std::size_t begin = patrol.size();
+	for (CityId node = parent(root); node != from; node = parent(node))
+		patrol.push_back(node);
+	std::reverse(patrol.begin() + static_cast<std::ptrdiff_t>(begin), patrol.end());
+}
+
+void PatrolBuilder::bidirectionalReturn(ComponentId component, CityId from) {
+	const CityId root = m_components.root(component);
+	auto inside = [&](CityId node) { return m_components.componentOf(node) == component; };
+
+	// Distâncias a partir de `from` em `m_mark`/`m_depth`; distâncias até a raiz em `m_workspace`,
+	// andando pelas estradas invertidas.
+	nextSearch();
+	m_mark[from] = m_search;
+	m_depth[from] = 0;
+	m_level.assign(1, from);
+
+	m_workspace.start(m_graph.size());
+	m_workspace.reach(root, 0, NO_CITY);
+	m_rootLevel.assign(1, root);
+
+	// Cada passo completa um nível do lado com menos cidades na fronteira. No primeiro nível em que
+	// as buscas se encontram, todo encontro tem o mesmo tamanho, e ele é o do caminho mais curto.
+	std::uint32_t forward = 0, backward = 0;
+	for (bool met = false; !met;) {
+		assert(!m_level.empty() && !m_rootLevel.empty());
+		m_nextLevel.clear();
+
+		if (m_level.size() <= m_rootLevel.size()) {
+			forward++;
+			for (CityId node : m_level) {
+				for (CityId target : m_graph.neighbors(node)) {
+					if (!inside(target) || m_mark[target] == m_search) continue;
+					m_mark[target] = m_search;
+					m_depth[target] = forward;
+					m_nextLevel.push_back(target);
+					met = met || m_workspace.reached(target);
+				}
+			}
+			std::swap(m_level, m_nextLevel);
+		}
+		else {
+			backward++;
+			for (CityId node : m_rootLevel) {
+				for (CityId source : m_reverse.neighbors(node)) {
+					if (!inside(source) || m_workspace.reached(source)) continue;
+					m_workspace.reach(source, backward, NO_CITY);
+					m_nextLevel.push_back(source);
+					met = met || m_mark[source] == m_search;
+				}
+			}
+			std::swap(m_rootLevel, m_nextLevel);
+		}
+	}
+	const std::uint32_t length = forward + backward;
+
+	// O desempate precisa da distância a partir de `from` de toda candidata. Depois do nível `forward`,
+	// só as cidades em algum caminho mais curto interessam: elas estão a `length - depth` da raiz e
+	// vêm de uma cidade do nível anterior que também está em um caminho mais curto.
+	std::erase_if(m_level, [&](CityId node) { return m_workspace.distance(node) != backward; });
+	for (std::uint32_t depth = forward + 1; depth < length; depth++) {
+		m_nextLevel.clear();
+		for (CityId node : m_level) {
+			for (CityId target : m_graph.neighbors(node)) {
+				if (!inside(target) || m_mark[target] == m_search || m_workspace.distance(target) != length - depth) continue;
+				m_mark[target] = m_search;
+				m_depth[target] = depth;
+				m_nextLevel.push_back(target);
+			}
+		}
+		std::swap(m_level, m_nextLevel);
+	}
+
+	// Da raiz para trás, cada cidade fica com a vizinha de menor posição no nível anterior, como na
+	// busca por níveis a partir de `from`.
+	CityId node = root;
+	for (std::uint32_t depth = length; depth > 0; depth--) {
+		CityId best = NO_CITY;
+		for (CityId source : m_reverse.neighbors(node)) {
+			if (!inside(source) || m_mark[source] != m_search || m_depth[source] != depth - 1) continue;
+			if (best == NO_CITY || m_rank[source] < m_rank[best]) best = source;
+		}
+		m_parent[node] = best;
+		node = best;
+	}
+}
+
+void PatrolBuilder::weightedReturn(ComponentId component, CityId from) {
+	const CityId root = m_components.root(component);
+
+	m_workspace.start(m_graph.size());
+	m_workspace.reach(from, 0, NO_CITY);
+
+	BucketQueue& queue = m_workspace.queue(m_graph.maxWeight());
+	queue.push(from, 0);
+
+	// Com pesos positivos, todas as vizinhas que dão a uma cidade a sua menor distância são fixadas
+	// antes dela, então o desempate vê todas as candidatas, como os níveis da BFS.
+	while (true) {
+		assert(!queue.empty());
+		Distance distance;
+		CityId node = queue.pop(distance);
+		if (distance > m_workspace.distance(node)) continue;
+		if (node == root) break;
+
+		for (EdgeIndex edge = m_graph.begin(node); edge < m_graph.end(node); edge++) {
+			CityId target = m_graph.target(edge);
+			if (m_components.componentOf(target) != component) continue;
+
+			Distance next = distance + m_graph.weight(edge);
+			if (next < m_workspace.distance(target)) {
+				m_workspace.reach(target, next, node);
+				queue.push(target, next);
+			}
+			else if (next == m_workspace.distance(target) && m_rank[node] < m_rank[m_workspace.parent(target)]) {
+				m_workspace.setParent(target, node);
+			}
+		}
+	}
+}
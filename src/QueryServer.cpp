@@ -0,0 +1,229 @@
+#include "QueryServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Algorithms.h"
+#include "MapReader.h"
+
+namespace {
+	/**
+	 * \brief Tamanho de cada bloco lido da conexão.
+	 */
+	constexpr std::size_t READ_BLOCK = 1 << 16;
+
+	bool isSpace(char c) {
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+	}
+
+	/**
+	 * \brief Separa o próximo token de `line`, removendo-o do início.
+	 */
+	std::string_view token(std::string_view& line) {
+		std::size_t start = 0;
+		while (start < line.size() && isSpace(line[start])) start++;
+
+		std::size_t end = start;
+		while (end < line.size() && !isSpace(line[end])) end++;
+
+		std::string_view word = line.substr(start, end - start);
+		line.remove_prefix(end);
+		return word;
+	}
+
+	bool writeAll(int fd, std::string_view data) {
+		while (!data.empty()) {
+			ssize_t count = write(fd, data.data(), data.size());
+			if (count < 0 && errno == EINTR) continue;
+			if (count <= 0) return false;
+			data.remove_prefix(static_cast<std::size_t>(count));
+		}
+		return true;
+	}
+}
+
+QueryServer::QueryServer(DynamicArchadian& map) : m_map(map) {}
+
+bool QueryServer::answer(std::string_view query, std::string& response) {
+	response.clear();
+
+	std::string_view command = token(query);
+	std::string_view first = token(query);
+	std::string_view second = token(query);
+	std::string_view third = token(query);
+
+	if (command.empty()) return true;
+	if (command == "quit") return false;
+
+	if (command == "capital") {
+		response.append(m_map.getName(m_map.getCapital()));
+		response.push_back('\n');
+		return true;
+	}
+
+	// As demais consultas recebem uma ou duas cidades.
+	std::size_t arguments = (command == "route" || command == "+" || command == "-") ? 2 : 1;
+	if (command != "scc" && command != "battalion" && arguments == 1) {
+		response.append("? ").append(command).push_back('\n');
+		return true;
+	}
+	if (first.empty() || (arguments == 2 && second.empty())) {
+		response.append("? ").append(command).append(" sem cidade\n");
+		return true;
+	}
+
+	CityId source = m_map.findCity(first);
+	CityId target = arguments == 2 ? m_map.findCity(second) : NO_CITY;
+
+	// Abrir uma estrada pode criar as cidades.
+	if (command == "+") {
+		Weight weight = 1;
+		if (!third.empty() && !MapReader::parseWeight(third, weight)) {
+			response.append("? peso ").append(third).push_back('\n');
+			return true;
+		}
+
+		if (source == NO_CITY) source = m_map.addCity(first);
+		if (target == NO_CITY) target = m_map.addCity(second);
+		m_map.addRoad(source, target, weight);
+		response.append("ok\n");
+		return true;
+	}
+
+	if (source == NO_CITY || (arguments == 2 && target == NO_CITY)) {
+		response.append("? ").append(source == NO_CITY ? first : second).push_back('\n');
+		return true;
+	}
+
+	if (command == "-") {
+		response.append(m_map.removeRoad(source, target) ? "ok\n" : "? sem estrada\n");
+	}
+	else if (command == "route") {
+		route(source, target, response);
+	}
+	else if (command == "scc") {
+		std::span<const CityId> component = m_map.getMembers(m_map.componentOf(source));
+		std::vector<CityId> members(component.begin(), component.end());
+		std::sort(members.begin(), members.end());
+
+		response.append(std::to_string(members.size()));
+		for (CityId city : members)
+			response.append(" ").append(m_map.getName(city));
+		response.push_back('\n');
+	}
+	else {
+		response.append(m_map.getName(m_map.getRepresentative(m_map.componentOf(source))));
+		response.push_back('\n');
+	}
+
+	return true;
+}
+
+void QueryServer::serve(int in, int out) {
+	std::vector<char> buffer(READ_BLOCK);
+	std::size_t size = 0;
+	std::string response;
+
+	while (true) {
+		if (size == buffer.size()) buffer.resize(2 * buffer.size());
+
+		ssize_t count = read(in, buffer.data() + size, buffer.size() - size);
+		if (count < 0 && errno == EINTR) continue;
+
+		bool end = count <= 0;
+		if (!end) size += static_cast<std::size_t>(count);
+
+		// Responde todas as linhas completas; no fim da entrada, também a última linha sem quebra.
+		std::size_t start = 0;
+		while (start < size) {
+			const void* newline = std::memchr(buffer.data() + start, '\n', size - start);
+			if (!newline && !end) break;
+
+			std::size_t stop = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - buffer.data()) : size;
+			std::string_view line(buffer.data() + start, stop - start);
+			start = newline ? stop + 1 : size;
+
+			if (!answer(line, response) || !writeAll(out, response)) return;
+		}
+
+		// A linha incompleta vai para o início do buffer.
+		std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(start), buffer.begin() + static_cast<std::ptrdiff_t>(size), buffer.begin());
+		size -= start;
+
+		if (end) return;
+	}
+}
+
+bool QueryServer::listen(const char* path) {
+	sockaddr_un address{};
+	if (std::strlen(path) >= sizeof(address.sun_path)) return false;
+	address.sun_family = AF_UNIX;
+	std::strcpy(address.sun_path, path);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) return false;
+
+	// Um socket deixado por uma execução anterior impediria o bind.
+	unlink(path);
+	if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listener, 16) < 0) {
+		close(listener);
+		return false;
+	}
+
+	// Um cliente que desconecta antes de ler a resposta não deve derrubar o servidor.
+	std::signal(SIGPIPE, SIG_IGN);
+
+	while (true) {
+		int client = accept(listener, nullptr, nullptr);
+		if (client < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			break;
+		}
+
+		serve(client, client);
+		close(client);
+	}
+
+	close(listener);
+	return true;
+}
+
+void QueryServer::route(CityId source, CityId target, std::string& response) {
+	// A ordem topológica das componentes descarta a busca sem visitar nenhuma estrada.
+	if (!m_map.mayReach(source, target)) {
+		response.append("-\n");
+		return;
+	}
+
+	// Cidades de componentes depois do destino não o alcançam, e cidades de componentes antes da
+	// origem não são alcançadas por ela: as duas pontas da busca ignoram essas estradas.
+	auto out = [this, target](CityId node, auto&& visit) {
+		std::span<const CityId> neighbors = m_map.neighbors(node);
+		std::span<const Weight> weights = m_map.weights(node);
+		for (std::size_t i = 0; i < neighbors.size(); i++)
+			if (m_map.mayReach(neighbors[i], target)) visit(neighbors[i], weights[i]);
+	};
+	auto in = [this, source](CityId node, auto&& visit) {
+		std::span<const CityId> predecessors = m_map.predecessors(node);
+		std::span<const Weight> weights = m_map.predecessorWeights(node);
+		for (std::size_t i = 0; i < predecessors.size(); i++)
+			if (m_map.mayReach(source, predecessors[i])) visit(predecessors[i], weights[i]);
+	};
+
+	// O mapa pode ter ganho cidades desde a última busca; o maior peso só cresce com as estradas abertas.
+	if (!Algorithms::BidirectionalSearch(source, target, m_map.size(), m_map.maxWeight(), m_forward, m_backward, out, in, m_path)) {
+		response.append("-\n");
+		return;
+	}
+
+	for (std::size_t i = 0; i < m_path.size(); i++) {
+		response.append(m_map.getName(m_path[i]));
+		response.push_back(i + 1 == m_path.size() ? '\n' : ' ');
+	}
+}
@@ -1,6 +1,6 @@
 #include "Road.h"
 
-Road::Road(City* source, City* target) : m_source(source), m_target(target) {}
+Road::Road(City* source, City* target, int weight) : m_source(source), m_target(target), m_weight(weight) {}
 
 City* Road::getSource() const {
 	return m_source;
@@ -11,5 +11,5 @@ City* Road::getTarget() const {
 }
 
 bool Road::operator==(const Road& other) const {
-	return m_source == other.getSource() && m_target == other.getTarget();
+	return m_source == other.getSource() && m_target == other.getTarget() && m_weight == other.getWeight();
 }
@@ -0,0 +1,33 @@
+#include "SearchWorkspace.h"
+
+#include <algorithm>
+
+SearchWorkspace::SearchWorkspace(std::size_t size)
+	: m_reached(size, 0), m_settled(size, 0), m_distance(size), m_parent(size), m_touched() {}
+
+void SearchWorkspace::start(std::size_t size) {
+	if (size > m_reached.size()) {
+		m_reached.resize(size, 0);
+		m_settled.resize(size, 0);
+		m_distance.resize(size);
+		m_parent.resize(size);
+	}
+
+	// A época 0 é a das cidades nunca marcadas; ao dar a volta, todas as marcas são apagadas.
+	if (++m_epoch == 0) {
+		std::fill(m_reached.begin(), m_reached.end(), 0);
+		std::fill(m_settled.begin(), m_settled.end(), 0);
+		m_epoch = 1;
+	}
+
+	m_touched.clear();
+	m_queue.clear();
+}
+
+BucketQueue& SearchWorkspace::queue(Weight maxWeight) {
+	if (maxWeight != m_queueWeight) {
+		m_queueWeight = maxWeight;
+		m_queue = BucketQueue(maxWeight, m_reached.size());
+	}
+	return m_queue;
+}
@@ -0,0 +1,34 @@
+#include "ShortestPathTree.h"
+
+#include <algorithm>
+
+ShortestPathTree::ShortestPathTree() : m_distance(), m_parent() {}
+
+ShortestPathTree::ShortestPathTree(CityId source, std::size_t size, const SearchWorkspace& workspace)
+	: m_source(source), m_distance(size, SearchWorkspace::UNREACHED), m_parent(size, NO_CITY) {
+	for (CityId node : workspace.touched()) {
+		m_distance[node] = workspace.distance(node);
+		m_parent[node] = workspace.parent(node);
+	}
+}
+
+std::size_t ShortestPathTree::hops(CityId target) const {
+	if (!reaches(target)) return 0;
+
+	std::size_t count = 0;
+	for (CityId node = target; node != m_source; node = m_parent[node])
+		count++;
+	return count;
+}
+
+std::vector<CityId> ShortestPathTree::path(CityId target) const {
+	std::vector<CityId> path;
+	if (!reaches(target)) return path;
+
+	path.reserve(hops(target));
+	for (CityId node : walk(target))
+		if (node != m_source) path.push_back(node);
+
+	std::reverse(path.begin(), path.end());
+	return path;
+}
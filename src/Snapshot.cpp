@@ -0,0 +1,269 @@
+#include "Snapshot.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct SnapshotHeader {
+	char magic[8];
+	std::uint32_t version;
+
+	/**
+	 * \brief `BYTE_ORDER_MARK` escrito na ordem de bytes de quem gerou o arquivo.
+	 */
+	std::uint32_t byteOrder;
+	std::uint64_t fileSize;
+
+	std::uint64_t cityCount;
+	std::uint64_t edgeCount;
+
+	/**
+	 * \brief Igual a `edgeCount` se o grafo tiver pesos, 0 caso contrário.
+	 */
+	std::uint64_t weightCount;
+	std::uint64_t nameBytes;
+	std::uint64_t componentCount;
+	std::uint64_t battalionCount;
+	std::uint64_t patrolCount;
+	std::uint64_t patrolCityCount;
+
+	std::uint32_t capital;
+	std::uint32_t hasBattalions;
+};
+
+namespace {
+	constexpr char MAGIC[8] = { 'A', 'R', 'C', 'H', 'S', 'N', 'A', 'P' };
+	constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+	/**
+	 * \brief Seções do arquivo, na ordem em que aparecem depois do cabeçalho.
+	 */
+	enum Section {
+		OUT_OFFSETS, OUT_TARGETS, OUT_WEIGHTS, IN_OFFSETS, IN_SOURCES, NAME_OFFSETS, NAME_BYTES,
+		COMPONENTS, BATTALIONS, PATROL_OFFSETS, PATROL_CITIES, SECTION_COUNT
+	};
+
+	std::size_t align(std::size_t bytes) {
+		return (bytes + 7) & ~static_cast<std::size_t>(7);
+	}
+
+	/**
+	 * \brief Calcula o início de cada seção e, na última posição, o tamanho do arquivo.
+	 */
+	std::array<std::size_t, SECTION_COUNT + 1> layout(const SnapshotHeader& header) {
+		const std::size_t bytes[SECTION_COUNT] = {
+			(header.cityCount + 1) * sizeof(EdgeIndex),
+			header.edgeCount * sizeof(CityId),
+			header.weightCount * sizeof(Weight),
+			(header.cityCount + 1) * sizeof(EdgeIndex),
+			header.edgeCount * sizeof(CityId),
+			(header.cityCount + 1) * sizeof(std::uint32_t),
+			header.nameBytes,
+			header.cityCount * sizeof(ComponentId),
+			header.battalionCount * sizeof(CityId),
+			(header.patrolCount + 1) * sizeof(std::uint64_t),
+			header.patrolCityCount * sizeof(CityId),
+		};
+
+		std::array<std::size_t, SECTION_COUNT + 1> offsets;
+		offsets[0] = align(sizeof(SnapshotHeader));
+		for (std::size_t section = 0; section < SECTION_COUNT; section++)
+			offsets[section + 1] = align(offsets[section] + bytes[section]);
+		return offsets;
+	}
+
+	template <typename T>
+	void append(std::vector<char>& file, std::size_t offset, const std::vector<T>& values) {
+		std::memcpy(file.data() + offset, values.data(), values.size() * sizeof(T));
+	}
+}
+
+bool Snapshot::write(const Archadian& archadian, const char* path) {
+	const Graph& graph = archadian.getGraph();
+	const Components& components = archadian.getComponents();
+	CityId size = static_cast<CityId>(graph.size());
+	if (components.count() == 0 && size > 0) return false;
+
+	std::vector<EdgeIndex> outOffsets(size + 1), inOffsets(size + 1, 0);
+	std::vector<CityId> outTargets(graph.edgeCount()), inSources(graph.edgeCount());
+	std::vector<Weight> outWeights;
+	for (CityId node = 0; node <= size; node++)
+		outOffsets[node] = node < size ? graph.begin(node) : static_cast<EdgeIndex>(graph.edgeCount());
+
+	// As estradas de entrada são agrupadas por destino, em ordem de origem, como em `Graph::transpose`.
+	for (EdgeIndex edge = 0; edge < graph.edgeCount(); edge++) {
+		outTargets[edge] = graph.target(edge);
+		inOffsets[graph.target(edge) + 1]++;
+		if (graph.isWeighted()) outWeights.push_back(graph.weight(edge));
+	}
+	for (CityId node = 0; node < size; node++)
+		inOffsets[node + 1] += inOffsets[node];
+
+	std::vector<EdgeIndex> next(inOffsets.begin(), inOffsets.end() - 1);
+	for (CityId node = 0; node < size; node++)
+		for (EdgeIndex edge = graph.begin(node); edge < graph.end(node); edge++)
+			inSources[next[graph.target(edge)]++] = node;
+
+	std::vector<std::uint32_t> nameOffsets(1, 0);
+	std::vector<char> nameBytes;
+	std::vector<ComponentId> component(size);
+	for (CityId node = 0; node < size; node++) {
+		std::string_view name = archadian.getName(node);
+		nameBytes.insert(nameBytes.end(), name.begin(), name.end());
+		nameOffsets.push_back(static_cast<std::uint32_t>(nameBytes.size()));
+		component[node] = components.componentOf(node);
+	}
+
+	std::vector<CityId> battalions(archadian.getBattalions().begin(), archadian.getBattalions().end());
+	std::vector<std::uint64_t> patrolOffsets(archadian.getPatrolOffsets().begin(), archadian.getPatrolOffsets().end());
+	std::vector<CityId> patrolCities(archadian.getPatrolCities().begin(), archadian.getPatrolCities().end());
+
+	SnapshotHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.cityCount = size;
+	header.edgeCount = graph.edgeCount();
+	header.weightCount = outWeights.size();
+	header.nameBytes = nameBytes.size();
+	header.componentCount = components.count();
+	header.battalionCount = battalions.size();
+	header.patrolCount = archadian.getPatrolCount();
+	header.patrolCityCount = patrolCities.size();
+	header.capital = archadian.getCapital();
+	header.hasBattalions = archadian.hasBattalions();
+
+	std::array<std::size_t, SECTION_COUNT + 1> offsets = layout(header);
+	header.fileSize = offsets[SECTION_COUNT];
+
+	std::vector<char> file(offsets[SECTION_COUNT], 0);
+	std::memcpy(file.data(), &header, sizeof(header));
+	append(file, offsets[OUT_OFFSETS], outOffsets);
+	append(file, offsets[OUT_TARGETS], outTargets);
+	append(file, offsets[OUT_WEIGHTS], outWeights);
+	append(file, offsets[IN_OFFSETS], inOffsets);
+	append(file, offsets[IN_SOURCES], inSources);
+	append(file, offsets[NAME_OFFSETS], nameOffsets);
+	append(file, offsets[NAME_BYTES], nameBytes);
+	append(file, offsets[COMPONENTS], component);
+	append(file, offsets[BATTALIONS], battalions);
+	append(file, offsets[PATROL_OFFSETS], patrolOffsets);
+	append(file, offsets[PATROL_CITIES], patrolCities);
+
+	// Escreve ao lado do destino e renomeia, para que nenhum leitor veja um arquivo pela metade.
+	std::string temporary = std::string(path) + ".tmp";
+	int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) return false;
+
+	std::size_t written = 0;
+	while (written < file.size()) {
+		ssize_t count = ::write(fd, file.data() + written, file.size() - written);
+		if (count < 0 && errno == EINTR) continue;
+		if (count <= 0) break;
+		written += static_cast<std::size_t>(count);
+	}
+
+	bool complete = close(fd) == 0 && written == file.size();
+	if (!complete || rename(temporary.c_str(), path) != 0) {
+		unlink(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+Snapshot::Snapshot(const char* path) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+		close(fd);
+		return;
+	}
+
+	std::size_t size = static_cast<std::size_t>(info.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return;
+
+	m_data = static_cast<const char*>(data);
+	m_size = size;
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data);
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION ||
+		header->byteOrder != BYTE_ORDER_MARK || header->fileSize != size)
+		return;
+
+	// Contagens maiores que o arquivo não cabem nele (e evitam estouro no cálculo das seções).
+	for (std::uint64_t count : { header->cityCount, header->edgeCount, header->weightCount, header->nameBytes,
+		header->battalionCount, header->patrolCount, header->patrolCityCount })
+		if (count > size) return;
+
+	std::array<std::size_t, SECTION_COUNT + 1> offsets = layout(*header);
+	if (offsets[SECTION_COUNT] != size) return;
+
+	auto section = [&]<typename T>(Section index, std::uint64_t count, std::span<const T>& span) {
+		span = std::span<const T>(reinterpret_cast<const T*>(m_data + offsets[index]), count);
+	};
+
+	std::uint64_t cities = header->cityCount;
+	section(OUT_OFFSETS, cities + 1, m_outOffsets);
+	section(OUT_TARGETS, header->edgeCount, m_outTargets);
+	section(OUT_WEIGHTS, header->weightCount, m_outWeights);
+	section(IN_OFFSETS, cities + 1, m_inOffsets);
+	section(IN_SOURCES, header->edgeCount, m_inSources);
+	section(NAME_OFFSETS, cities + 1, m_nameOffsets);
+	section(NAME_BYTES, header->nameBytes, m_nameBytes);
+	section(COMPONENTS, cities, m_component);
+	section(BATTALIONS, header->battalionCount, m_battalions);
+	section(PATROL_OFFSETS, header->patrolCount + 1, m_patrolOffsets);
+	section(PATROL_CITIES, header->patrolCityCount, m_patrolCities);
+
+	// As seções de tamanho variável terminam onde o cabeçalho diz.
+	if (m_outOffsets.back() != header->edgeCount || m_inOffsets.back() != header->edgeCount ||
+		m_nameOffsets.back() != header->nameBytes || m_patrolOffsets.back() != header->patrolCityCount)
+		return;
+
+	m_header = header;
+}
+
+Snapshot::~Snapshot() {
+	if (m_data) munmap(const_cast<char*>(m_data), m_size);
+}
+
+std::size_t Snapshot::size() const { return m_header->cityCount; }
+
+std::span<const CityId> Snapshot::neighbors(CityId city) const {
+	return m_outTargets.subspan(m_outOffsets[city], m_outOffsets[city + 1] - m_outOffsets[city]);
+}
+
+std::span<const CityId> Snapshot::predecessors(CityId city) const {
+	return m_inSources.subspan(m_inOffsets[city], m_inOffsets[city + 1] - m_inOffsets[city]);
+}
+
+std::span<const Weight> Snapshot::weights(CityId city) const {
+	if (m_outWeights.empty()) return {};
+	return m_outWeights.subspan(m_outOffsets[city], m_outOffsets[city + 1] - m_outOffsets[city]);
+}
+
+std::string_view Snapshot::getName(CityId city) const {
+	if (city == NO_CITY) return {};
+	return std::string_view(m_nameBytes.data() + m_nameOffsets[city], m_nameOffsets[city + 1] - m_nameOffsets[city]);
+}
+
+std::size_t Snapshot::componentCount() const { return m_header->componentCount; }
+
+CityId Snapshot::getCapital() const { return m_header->capital; }
+
+bool Snapshot::hasBattalions() const { return m_header->hasBattalions != 0; }
+
+Patrolling Snapshot::getPatrolling(std::size_t patrol) const {
+	return m_patrolCities.subspan(m_patrolOffsets[patrol], m_patrolOffsets[patrol + 1] - m_patrolOffsets[patrol]);
+}
@@ -0,0 +1,114 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threads) {
+	if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+	m_ranges = std::make_unique<Range[]>(threads);
+
+	m_threads.reserve(threads - 1);
+	for (std::size_t worker = 1; worker < threads; worker++)
+		m_threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (std::thread& thread : m_threads)
+		thread.join();
+}
+
+void ThreadPool::run(std::size_t count, const Task& task) {
+	if (m_threads.empty()) {
+		for (std::size_t i = 0; i < count; i++)
+			task(i, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		for (std::size_t worker = 0; worker < size(); worker++) {
+			std::lock_guard<std::mutex> rangeLock(m_ranges[worker].mutex);
+			m_ranges[worker].begin = worker * count / size();
+			m_ranges[worker].end = (worker + 1) * count / size();
+		}
+		m_busy = m_threads.size();
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	drain(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [&] { return m_busy == 0; });
+	m_task = nullptr;
+}
+
+void ThreadPool::workerLoop(std::size_t worker) {
+	std::size_t generation = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&] { return m_stop || m_generation != generation; });
+			if (m_stop) return;
+			generation = m_generation;
+		}
+
+		drain(worker);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_busy--;
+		}
+		m_done.notify_one();
+	}
+}
+
+void ThreadPool::drain(std::size_t worker) {
+	std::size_t task;
+	while (take(worker, task) || steal(worker, task))
+		(*m_task)(task, worker);
+}
+
+bool ThreadPool::take(std::size_t worker, std::size_t& task) {
+	Range& range = m_ranges[worker];
+	std::lock_guard<std::mutex> lock(range.mutex);
+
+	if (range.begin == range.end) return false;
+
+	task = range.begin++;
+	return true;
+}
+
+bool ThreadPool::steal(std::size_t worker, std::size_t& task) {
+	for (std::size_t offset = 1; offset < size(); offset++) {
+		Range& victim = m_ranges[(worker + offset) % size()];
+
+		std::size_t begin, end;
+		{
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.begin == victim.end) continue;
+
+			// A vítima continua com a metade inicial; com uma única tarefa, ela é roubada.
+			begin = victim.begin + (victim.end - victim.begin) / 2;
+			end = victim.end;
+			victim.end = begin;
+		}
+
+		Range& range = m_ranges[worker];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		range.begin = begin + 1;
+		range.end = end;
+		task = begin;
+		return true;
+	}
+
+	return false;
+}
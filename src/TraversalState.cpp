@@ -0,0 +1,15 @@
+#include "TraversalState.h"
+
+TraversalState::TraversalState() : m_colors(), m_discovery(), m_finish(), m_postorder() {}
+
+TraversalState::TraversalState(std::size_t size) : TraversalState() {
+	reset(size);
+}
+
+void TraversalState::reset(std::size_t size) {
+	m_colors.assign((size + 31) / 32, 0);
+	m_discovery.assign(size, 0);
+	m_finish.assign(size, 0);
+	m_postorder.clear();
+	m_postorder.reserve(size);
+}
@@ -0,0 +1,166 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "Archadian.h"
+#include "BucketQueue.h"
+
+namespace {
+	Archadian buildArchadian(std::size_t size, const std::vector<Edge>& edges) {
+		NameTable names;
+		std::vector<City> cities;
+		for (std::size_t i = 0; i < size; i++)
+			cities.push_back(City(i + 1, names.add("c" + std::to_string(i))));
+
+		return Archadian(std::move(cities), Graph(size, edges), std::move(names));
+	}
+}
+
+// Os resultados so expostos como identificadores, sem cpia de cidades
+BOOST_AUTO_TEST_CASE(Archadian_ResultIds) {
+	// {0, 1, 2} -> {3, 4} -> {5}
+	Archadian archadian = buildArchadian(6, {
+		{ 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 }, { 3, 4 }, { 4, 3 }, { 4, 5 } });
+
+	archadian.calcCapital();
+	archadian.calcBattalionsAndPatrolling();
+
+	BOOST_CHECK(archadian.getCapital() == 2);
+	BOOST_CHECK(archadian.getName(archadian.getCapital()) == "c2");
+	BOOST_CHECK(archadian.getName(NO_CITY).empty());
+
+	BOOST_CHECK(archadian.hasBattalions());
+	Battalions battalions = archadian.getBattalions();
+	BOOST_REQUIRE(battalions.size() == 2);
+	BOOST_CHECK(battalions[0] == 3);
+	BOOST_CHECK(battalions[1] == 5);
+
+	// Uma patrulha por componente com mais de uma cidade, concatenadas em um nico vetor.
+	BOOST_REQUIRE(archadian.getPatrolCount() == 2);
+	BOOST_REQUIRE(archadian.getPatrolOffsets().size() == 3);
+	BOOST_CHECK(archadian.getPatrolOffsets().back() == archadian.getPatrolCities().size());
+
+	Patrolling first = archadian.getPatrolling(0);
+	BOOST_CHECK(first.data() == archadian.getPatrolCities().data());
+	BOOST_CHECK(first[0] == 2);
+	for (CityId city : { 0, 1, 2 })
+		BOOST_CHECK(std::find(first.begin(), first.end(), city) != first.end());
+
+	Patrolling second = archadian.getPatrolling(1);
+	BOOST_CHECK(second[0] == 3);
+	BOOST_CHECK(std::find(second.begin(), second.end(), 4) != second.end());
+}
+
+// Um grafo novo descarta as componentes do anterior
+BOOST_AUTO_TEST_CASE(Archadian_SetGraph) {
+	// 0 -> 1 -> 2, depois invertido.
+	Archadian archadian = buildArchadian(3, { { 0, 1 }, { 1, 2 } });
+	archadian.calcCapital();
+	BOOST_CHECK(archadian.getCapital() == 0);
+	BOOST_CHECK(archadian.getCondensationStart() == 0);
+
+	archadian.setGraph(archadian.getGraph().transpose());
+	BOOST_CHECK(archadian.getCondensationStart() == NO_CITY);
+
+	archadian.calcCapital();
+	BOOST_CHECK(archadian.getCapital() == 2);
+	BOOST_CHECK(archadian.getComponents().count() == 3);
+}
+
+// As patrulhas construdas em paralelo so emitidas na mesma ordem da construo sequencial
+BOOST_AUTO_TEST_CASE(Archadian_ParallelPatrols) {
+	// Uma cadeia de 40 ciclos de tamanhos diferentes.
+	std::vector<Edge> edges;
+	CityId size = 0;
+	for (CityId cycle = 0; cycle < 40; cycle++) {
+		CityId length = 2 + (cycle * 7) % 11;
+		for (CityId i = 0; i < length; i++)
+			edges.push_back({ size + i, size + (i + 1) % length });
+		if (cycle > 0) edges.push_back({ size - 1, size });
+		size += length;
+	}
+
+	Archadian serial = buildArchadian(size, edges);
+	serial.calcCapital();
+	serial.calcBattalionsAndPatrolling(1);
+
+	Archadian parallel = buildArchadian(size, edges);
+	parallel.calcCapital(4);
+	parallel.calcBattalionsAndPatrolling(4);
+
+	BOOST_CHECK(serial.getPatrolCount() == 40);
+	BOOST_CHECK(parallel.getCapital() == serial.getCapital());
+	BOOST_CHECK(std::ranges::equal(parallel.getBattalions(), serial.getBattalions()));
+	BOOST_CHECK(std::ranges::equal(parallel.getPatrolOffsets(), serial.getPatrolOffsets()));
+	BOOST_CHECK(std::ranges::equal(parallel.getPatrolCities(), serial.getPatrolCities()));
+}
+
+// Com e sem pesos, as patrulhas seguem o sentido das estradas, inclusive na volta para o batalho
+BOOST_AUTO_TEST_CASE(Archadian_PatrolsFollowRoads) {
+	std::mt19937 random(17);
+	std::size_t patrols = 0;
+
+	for (int round = 0; round < 100; round++) {
+		std::size_t n = 2 + random() % 30;
+		Weight maxWeight = round % 2 == 0 ? 1 : 20;
+		std::vector<Edge> edges;
+		for (std::size_t i = 2 * n; i > 0; i--)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n), static_cast<Weight>(1 + random() % maxWeight) });
+
+		Archadian archadian = buildArchadian(n, edges);
+		archadian.calcCapital();
+		archadian.calcBattalionsAndPatrolling(2);
+
+		// Cada cidade, e a primeira depois da ltima,  destino de uma estrada que sai da anterior, exceto
+		// quando a DFS volta a uma cidade j visitada para descobrir a prxima a partir dela.
+		const Graph& graph = archadian.getGraph();
+		auto isRoad = [&](CityId source, CityId target) {
+			auto neighbors = graph.neighbors(source);
+			return std::find(neighbors.begin(), neighbors.end(), target) != neighbors.end();
+		};
+
+		for (std::size_t patrol = 0; patrol < archadian.getPatrolCount(); patrol++, patrols++) {
+			Patrolling cities = archadian.getPatrolling(patrol);
+			std::vector<bool> visited(n, false);
+			for (std::size_t i = 0; i < cities.size(); i++) {
+				visited[cities[i]] = true;
+				CityId next = cities[(i + 1) % cities.size()];
+				bool back = i + 2 < cities.size() && visited[next] && !visited[cities[i + 2]] && isRoad(next, cities[i + 2]);
+				BOOST_REQUIRE(isRoad(cities[i], next) || back);
+			}
+		}
+	}
+
+	BOOST_CHECK(patrols > 50);
+}
+
+// Pesos acima de `MAX_BUCKETS` passam a capital e as patrulhas para o heap sem mudar o resultado
+BOOST_AUTO_TEST_CASE(Archadian_LargeWeights) {
+	std::mt19937 random(41);
+	const Weight scale = BucketQueue::MAX_BUCKETS + 1;
+
+	for (int round = 0; round < 50; round++) {
+		std::size_t n = 2 + random() % 30;
+		std::vector<Edge> edges, scaled;
+		for (std::size_t i = 2 * n; i > 0; i--) {
+			Edge edge{ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n), static_cast<Weight>(2 + random() % 20) };
+			edges.push_back(edge);
+			scaled.push_back({ edge.source, edge.target, edge.weight * scale });
+		}
+
+		Archadian buckets = buildArchadian(n, edges);
+		buckets.calcCapital();
+		buckets.calcBattalionsAndPatrolling();
+
+		Archadian heap = buildArchadian(n, scaled);
+		heap.calcCapital();
+		heap.calcBattalionsAndPatrolling();
+
+		BOOST_REQUIRE(heap.getCapital() == buckets.getCapital());
+		BOOST_REQUIRE(std::ranges::equal(heap.getBattalions(), buckets.getBattalions()));
+		BOOST_REQUIRE(std::ranges::equal(heap.getPatrolOffsets(), buckets.getPatrolOffsets()));
+		BOOST_REQUIRE(std::ranges::equal(heap.getPatrolCities(), buckets.getPatrolCities()));
+	}
+}
@@ -0,0 +1,60 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "BucketQueue.h"
+
+// A fila devolve as cidades em ordem de distncia, com baldes e com o heap
+BOOST_AUTO_TEST_CASE(BucketQueue_MonotoneOrder) {
+	std::mt19937 random(5);
+
+	for (Weight maxWeight : { Weight{ 1 }, Weight{ 7 }, BucketQueue::MAX_BUCKETS, 4 * BucketQueue::MAX_BUCKETS }) {
+		BucketQueue queue(maxWeight);
+		BOOST_CHECK(queue.usesBuckets() == (maxWeight <= BucketQueue::MAX_BUCKETS));
+
+		// Uma busca simulada: cada cidade retirada insere outras at `maxWeight`  frente.
+		for (int round = 0; round < 2; round++) {
+			queue.clear();
+			queue.push(0, 0);
+
+			Distance last = 0;
+			CityId next = 1;
+			while (!queue.empty()) {
+				Distance distance;
+				queue.pop(distance);
+				BOOST_REQUIRE(distance >= last);
+				last = distance;
+
+				for (int i = 0; i < 3 && next < 500; i++)
+					queue.push(next++, distance + 1 + random() % maxWeight);
+			}
+
+			BOOST_CHECK(next == 500);
+		}
+	}
+}
+
+// Cidades de mesma distncia saem juntas, e `clear` descarta o que sobrou na fila
+BOOST_AUTO_TEST_CASE(BucketQueue_Clear) {
+	BucketQueue queue(3);
+	queue.push(4, 2);
+	queue.push(5, 1);
+	queue.push(6, 2);
+
+	Distance distance;
+	BOOST_CHECK(queue.pop(distance) == 5 && distance == 1);
+
+	CityId first = queue.pop(distance);
+	BOOST_CHECK(distance == 2);
+	BOOST_CHECK(queue.pop(distance) == (first == 4 ? 6 : 4) && distance == 2);
+	BOOST_CHECK(queue.empty());
+
+	queue.push(7, 3);
+	queue.clear();
+	BOOST_CHECK(queue.empty());
+
+	// Depois de `clear`, as distncias recomeam do zero.
+	queue.push(8, 0);
+	BOOST_CHECK(queue.pop(distance) == 8 && distance == 0);
+}
@@ -0,0 +1,245 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "Algorithms.h"
+#include "CapitalFinder.h"
+
+namespace {
+	// Escolha da capital somando o tamanho dos caminhos de Dijkstra, como era feito antes do CapitalFinder.
+	CityId dijkstraCapital(const Graph& graph) {
+		CityId capital = NO_CITY;
+		std::size_t best = 0;
+
+		for (CityId node = 0; node < graph.size(); node++) {
+			ShortestPathTree tree = Algorithms::Dijkstra(graph, node);
+
+			std::size_t reached = 0, sum = 0;
+			for (CityId target = 0; target < graph.size(); target++) {
+				if (target == node || !tree.reaches(target)) continue;
+				reached++;
+				sum += tree.hops(target);
+			}
+
+			if (reached == graph.size() - 1 && sum > 0 && (capital == NO_CITY || sum < best)) {
+				best = sum;
+				capital = node;
+			}
+		}
+
+		return capital;
+	}
+
+	Graph randomGraph(std::mt19937& random) {
+		std::size_t n = 1 + random() % 30;
+		std::size_t m = random() % (4 * n);
+
+		std::vector<Edge> edges;
+		for (std::size_t i = 0; i < m; i++)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n) });
+
+		return Graph(n, edges);
+	}
+
+	// Capital pelas distncias com pesos de Floyd-Warshall, com os mesmos critrios do CapitalFinder.
+	CityId floydCapital(std::size_t n, const std::vector<Edge>& edges) {
+		const Distance INFINITE = std::numeric_limits<Distance>::max() / 4;
+		std::vector<std::vector<Distance>> distance(n, std::vector<Distance>(n, INFINITE));
+		for (std::size_t node = 0; node < n; node++) distance[node][node] = 0;
+		for (const Edge& edge : edges)
+			distance[edge.source][edge.target] = std::min(distance[edge.source][edge.target], Distance{ edge.weight });
+
+		for (std::size_t k = 0; k < n; k++)
+			for (std::size_t i = 0; i < n; i++)
+				for (std::size_t j = 0; j < n; j++)
+					distance[i][j] = std::min(distance[i][j], distance[i][k] + distance[k][j]);
+
+		CityId capital = NO_CITY;
+		Distance best = 0;
+		for (CityId node = 0; node < n; node++) {
+			Distance sum = 0;
+			for (Distance value : distance[node]) sum = value == INFINITE || sum == INFINITE ? INFINITE : sum + value;
+
+			if (sum != INFINITE && sum > 0 && (capital == NO_CITY || sum < best)) {
+				best = sum;
+				capital = node;
+			}
+		}
+		return capital;
+	}
+}
+
+// Teste da soma de distncias calculada pela BFS
+BOOST_AUTO_TEST_CASE(Capital_DistanceSum) {
+	// 0 -> 1 -> 2 -> 3 e 0 -> 2; 3 -> 0 fecha o ciclo.
+	Graph graph(4, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 0, 2 }, { 3, 0 } });
+	CapitalFinder finder(graph);
+
+	BOOST_CHECK(finder.distanceSum(0) == 1 + 1 + 2);
+	BOOST_CHECK(finder.distanceSum(1) == 1 + 2 + 3);
+	BOOST_CHECK(finder.distanceSum(3) == 1 + 2 + 2);
+
+	// A busca  interrompida quando a soma atinge o limite.
+	BOOST_CHECK(finder.distanceSum(1, 6) == CapitalFinder::REJECTED);
+	BOOST_CHECK(finder.distanceSum(1, 7) == 6);
+
+	BOOST_CHECK(finder.find() == 0);
+}
+
+// Cidades que no alcanam todas as outras no podem ser a capital
+BOOST_AUTO_TEST_CASE(Capital_Unreachable) {
+	Graph graph(3, { { 0, 1 }, { 1, 0 } });
+	CapitalFinder finder(graph);
+
+	BOOST_CHECK(finder.distanceSum(0) == CapitalFinder::REJECTED);
+	BOOST_CHECK(finder.distanceSum(2) == CapitalFinder::REJECTED);
+	BOOST_CHECK(finder.find() == NO_CITY);
+
+	// Uma nica cidade no tem capital: a soma das distncias  zero.
+	Graph single(1, {});
+	BOOST_CHECK(CapitalFinder(single).find() == NO_CITY);
+}
+
+// Em caso de empate, a cidade de menor identificador  a capital
+BOOST_AUTO_TEST_CASE(Capital_TieBreak) {
+	Graph graph(3, { { 0, 1 }, { 1, 2 }, { 2, 0 } });
+
+	BOOST_CHECK(CapitalFinder(graph).find() == 0);
+}
+
+// A BFS escolhe a mesma capital que a soma dos caminhos de Dijkstra
+BOOST_AUTO_TEST_CASE(Capital_MatchesDijkstra) {
+	std::mt19937 random(7);
+
+	for (int round = 0; round < 300; round++) {
+		Graph graph = randomGraph(random);
+		BOOST_CHECK(CapitalFinder(graph).find() == dijkstraCapital(graph));
+	}
+}
+
+// As BFSs simultneas calculam as mesmas somas que uma BFS por cidade
+BOOST_AUTO_TEST_CASE(Capital_BitParallelSums) {
+	std::mt19937 random(11);
+
+	for (int round = 0; round < 100; round++) {
+		Graph graph = randomGraph(random);
+		CapitalFinder finder(graph);
+
+		std::vector<CityId> sources;
+		for (CityId node = 0; node < graph.size() && sources.size() < CapitalFinder::BATCH_SIZE; node++)
+			sources.push_back(node);
+
+		std::vector<Distance> sums(sources.size());
+		finder.distanceSums(sources, sums);
+
+		for (std::size_t i = 0; i < sources.size(); i++)
+			BOOST_CHECK(sums[i] == finder.distanceSum(sources[i]));
+	}
+}
+
+// As duas estratgias escolhem a mesma capital, inclusive com mais de um lote
+BOOST_AUTO_TEST_CASE(Capital_BitParallelMatchesPerSource) {
+	std::mt19937 random(13);
+
+	for (int round = 0; round < 100; round++) {
+		Graph graph = randomGraph(random);
+		CapitalFinder finder(graph);
+		BOOST_CHECK(finder.find(CapitalFinder::Strategy::BIT_PARALLEL) == finder.find(CapitalFinder::Strategy::PER_SOURCE));
+	}
+
+	// Um ciclo de 200 cidades: todas empatam e a capital  a primeira, no primeiro lote.
+	std::vector<Edge> cycle;
+	for (CityId node = 0; node < 200; node++)
+		cycle.push_back({ node, (node + 1) % 200 });
+
+	Graph graph(200, cycle);
+	BOOST_CHECK(CapitalFinder(graph).find(CapitalFinder::Strategy::BIT_PARALLEL) == 0);
+
+	// Um atalho desfaz o empate, e a capital passa a estar fora do primeiro lote.
+	cycle.push_back({ 150, 50 });
+	Graph shortcut(200, cycle);
+	CapitalFinder finder(shortcut);
+	BOOST_CHECK(finder.find(CapitalFinder::Strategy::BIT_PARALLEL) == finder.find(CapitalFinder::Strategy::PER_SOURCE));
+}
+
+// A busca com vrias threads escolhe a mesma capital que a busca sequencial
+BOOST_AUTO_TEST_CASE(Capital_MultithreadedMatchesSerial) {
+	std::mt19937 random(17);
+
+	for (int round = 0; round < 50; round++) {
+		// Grafos maiores, para que existam vrias tarefas por thread.
+		std::size_t n = 1 + random() % 400;
+		std::vector<Edge> edges;
+		for (CityId node = 0; node < n; node++) {
+			edges.push_back({ node, static_cast<CityId>((node + 1) % n) });
+			edges.push_back({ node, static_cast<CityId>(random() % n) });
+		}
+
+		Graph graph(n, edges);
+		for (auto strategy : { CapitalFinder::Strategy::PER_SOURCE, CapitalFinder::Strategy::BIT_PARALLEL }) {
+			CityId serial = CapitalFinder(graph).find(strategy, 1);
+			BOOST_CHECK(CapitalFinder(graph).find(strategy, 4) == serial);
+			BOOST_CHECK(CapitalFinder(graph).find(strategy, 0) == serial);
+		}
+	}
+}
+
+// S as cidades da nica componente fonte so candidatas a capital
+BOOST_AUTO_TEST_CASE(Capital_SourceComponentCandidates) {
+	// {3, 1} -> {0, 2} -> {4}
+	Graph graph(5, { { 3, 1 }, { 1, 3 }, { 1, 0 }, { 0, 2 }, { 2, 0 }, { 2, 4 } });
+	CapitalFinder finder(graph);
+
+	BOOST_CHECK((finder.candidates() == std::vector<CityId>{ 1, 3 }));
+	BOOST_CHECK(finder.find() == 1);
+
+	// Com duas componentes fontes, nenhuma cidade alcana todas as outras.
+	Graph twoSources(4, { { 0, 1 }, { 2, 1 }, { 1, 3 } });
+	BOOST_CHECK(CapitalFinder(twoSources).candidates().empty());
+	BOOST_CHECK(CapitalFinder(twoSources).find() == NO_CITY);
+}
+
+// A busca restrita aos candidatos escolhe a mesma capital que a busca em todas as cidades
+BOOST_AUTO_TEST_CASE(Capital_PruningMatchesAllSources) {
+	std::mt19937 random(19);
+
+	for (int round = 0; round < 200; round++) {
+		Graph graph = randomGraph(random);
+		CapitalFinder finder(graph);
+
+		std::vector<CityId> all(graph.size());
+		for (CityId node = 0; node < graph.size(); node++)
+			all[node] = node;
+
+		for (auto strategy : { CapitalFinder::Strategy::PER_SOURCE, CapitalFinder::Strategy::BIT_PARALLEL })
+			BOOST_CHECK(finder.find(strategy) == finder.find(all, strategy));
+	}
+}
+
+// Com pesos, a capital  a de menor soma de distncias com pesos, nos baldes e no heap
+BOOST_AUTO_TEST_CASE(Capital_WeightedRoads) {
+	// Sem pesos, 0 e 1 empatam e vence 0; a estrada pesada 0 -> 1 muda a capital para 1.
+	Graph graph(3, { { 0, 1, 5 }, { 1, 0 }, { 1, 2 }, { 2, 0 } });
+	CapitalFinder finder(graph);
+	BOOST_CHECK(finder.distanceSum(0) == 5 + 6);
+	BOOST_CHECK(finder.distanceSum(1) == 1 + 1);
+	BOOST_CHECK(finder.distanceSum(1, 2) == CapitalFinder::REJECTED);
+	BOOST_CHECK(finder.find() == 1);
+
+	std::mt19937 random(17);
+	for (int round = 0; round < 300; round++) {
+		std::size_t n = 1 + random() % 20;
+		std::size_t m = random() % (4 * n);
+		Weight maxWeight = round % 2 == 0 ? 9 : 2 * BucketQueue::MAX_BUCKETS;
+
+		std::vector<Edge> edges;
+		for (std::size_t i = 0; i < m; i++)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n),
+				static_cast<Weight>(1 + random() % maxWeight) });
+
+		Graph weighted(n, edges);
+		BOOST_CHECK(CapitalFinder(weighted).find(CapitalFinder::Strategy::BIT_PARALLEL, 2) == floydCapital(n, edges));
+	}
+}
@@ -0,0 +1,101 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <set>
+
+#include "Algorithms.h"
+#include "Archadian.h"
+#include "CapitalFinder.h"
+#include "Condensation.h"
+
+namespace {
+	std::vector<CityId> identityOrder(std::size_t size) {
+		std::vector<CityId> order(size);
+		for (std::size_t i = 0; i < size; i++)
+			order[i] = static_cast<CityId>(i);
+		return order;
+	}
+}
+
+// As estradas entre componentes viram arestas do DAG, sem repeties e em ordem crescente
+BOOST_AUTO_TEST_CASE(Condensation_Edges) {
+	// {0, 1} -> {2, 3} -> {4}, com estradas paralelas de {0, 1} para {2, 3} e {0, 1} -> {4}.
+	Graph graph(5, { { 0, 1 }, { 1, 0 }, { 0, 2 }, { 1, 3 }, { 1, 4 }, { 2, 3 }, { 3, 2 }, { 3, 4 }, { 2, 4 } });
+	Condensation condensation(graph, Algorithms::Pearce(graph, identityOrder(5)));
+
+	BOOST_REQUIRE(condensation.count() == 3);
+	BOOST_CHECK(condensation.componentOf(0) == 0 && condensation.componentOf(3) == 1 && condensation.componentOf(4) == 2);
+	BOOST_CHECK(condensation.size(0) == 2 && condensation.size(2) == 1);
+
+	BOOST_CHECK((std::vector<ComponentId>(condensation.successors(0).begin(), condensation.successors(0).end()) == std::vector<ComponentId>{ 1, 2 }));
+	BOOST_CHECK((std::vector<ComponentId>(condensation.successors(1).begin(), condensation.successors(1).end()) == std::vector<ComponentId>{ 2 }));
+	BOOST_CHECK(condensation.successors(2).empty());
+	BOOST_CHECK(condensation.edgeCount() == 3);
+
+	BOOST_CHECK(condensation.inDegree(0) == 0 && condensation.inDegree(1) == 1 && condensation.inDegree(2) == 2);
+	BOOST_CHECK(condensation.sourceCount() == 1);
+
+	// Duas fontes: nenhuma cidade alcana todas as outras.
+	Graph split(3, { { 0, 2 }, { 1, 2 } });
+	Condensation sources(split, Algorithms::Pearce(split, identityOrder(3)));
+	BOOST_CHECK(sources.sourceCount() == 2);
+	BOOST_CHECK(CapitalFinder::candidates(sources).empty());
+	BOOST_CHECK(Condensation().count() == 0);
+}
+
+// Toda estrada entre componentes diferentes tem a sua aresta no DAG, e nenhuma aresta sobra
+BOOST_AUTO_TEST_CASE(Condensation_MatchesRoads) {
+	std::mt19937 random(37);
+
+	for (int round = 0; round < 100; round++) {
+		std::size_t n = 1 + random() % 40;
+		std::vector<Edge> edges;
+		for (std::size_t i = random() % (3 * n); i > 0; i--)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n) });
+		Graph graph(n, edges);
+		Condensation condensation(graph, Algorithms::Pearce(graph, identityOrder(n)));
+
+		std::set<std::pair<ComponentId, ComponentId>> expected;
+		for (const Edge& edge : edges)
+			if (condensation.componentOf(edge.source) != condensation.componentOf(edge.target))
+				expected.insert({ condensation.componentOf(edge.source), condensation.componentOf(edge.target) });
+
+		std::set<std::pair<ComponentId, ComponentId>> found;
+		std::vector<std::size_t> inDegree(condensation.count(), 0);
+		for (ComponentId component = 0; component < condensation.count(); component++) {
+			ComponentId previous = component;
+			for (ComponentId next : condensation.successors(component)) {
+				BOOST_REQUIRE(next > previous);
+				found.insert({ component, next });
+				inDegree[next]++;
+				previous = next;
+			}
+		}
+
+		BOOST_REQUIRE(found == expected);
+		BOOST_REQUIRE(condensation.edgeCount() == expected.size());
+		for (ComponentId component = 0; component < condensation.count(); component++)
+			BOOST_REQUIRE(condensation.inDegree(component) == inDegree[component]);
+	}
+}
+
+// A condensao da capital  reaproveitada pelos batalhes quando a DFS comea pela mesma cidade
+BOOST_AUTO_TEST_CASE(Condensation_SharedByArchadian) {
+	for (CityId capital : { CityId{ 0 }, CityId{ 2 } }) {
+		// Ciclo 0 -> 1 -> 2 -> 0, com a capital em `capital` por causa das estradas para 3 e 4.
+		std::vector<Edge> edges{ { 0, 1 }, { 1, 2 }, { 2, 0 }, { capital, 3 }, { capital, 4 }, { 3, 4 } };
+		std::vector<City> cities;
+		for (std::size_t i = 0; i < 5; i++) cities.push_back(City(i + 1));
+		Archadian archadian(std::move(cities), Graph(5, edges));
+
+		archadian.calcCapital();
+		BOOST_REQUIRE(archadian.getCapital() == capital);
+		BOOST_CHECK(archadian.getCondensationStart() == 0);
+
+		// Com a capital na cidade 0, a condensao  a mesma; seno, a DFS recomea pela capital.
+		archadian.calcBattalionsAndPatrolling();
+		BOOST_CHECK(archadian.getCondensationStart() == capital);
+		BOOST_CHECK(archadian.getComponents().root(0) == capital);
+		BOOST_CHECK(archadian.getCondensation().count() == 3);
+	}
+}
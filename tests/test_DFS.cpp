@@ -43,10 +43,8 @@ BOOST_AUTO_TEST_CASE(DFS_VisitsAllVertices) {
 	BOOST_CHECK(visited.find(node3) != visited.end());
 	BOOST_CHECK(visited.find(node4) != visited.end());
 
-	auto [colors, discovery_times, finishing_times] = dfs_data;
-
 	for (auto& node : { &node1, &node2, &node3, &node4 }) {
-		BOOST_CHECK(colors[node] == CityColor::FINISHED);
+		BOOST_CHECK(dfs_data.getColor(Archadian.getId(*node)) == CityColor::FINISHED);
 	}
 
 	std::unordered_map<City*, std::size_t, CityHash, CityEqual> expected_discovery_times = {
@@ -64,11 +62,11 @@ BOOST_AUTO_TEST_CASE(DFS_VisitsAllVertices) {
 	};
 
 	for (auto& node : { &node1, &node2, &node3, &node4 }) {
-		BOOST_CHECK(discovery_times.find(node) != discovery_times.end());
-		BOOST_CHECK(finishing_times.find(node) != finishing_times.end());
+		CityId id = Archadian.getId(*node);
+		BOOST_CHECK(id != NO_CITY);
 
-		DiscoveryTime d_time = discovery_times[node];
-		FinishingTime f_time = finishing_times[node];
+		DiscoveryTime d_time = dfs_data.getDiscoveryTime(id);
+		FinishingTime f_time = dfs_data.getFinishingTime(id);
 
 		BOOST_CHECK(d_time < f_time);
 
@@ -105,10 +103,8 @@ BOOST_AUTO_TEST_CASE(DFS_ComplexArchadianTraversal) {
 	BOOST_CHECK(visited.find(node6) != visited.end());
 	BOOST_CHECK(visited.find(node7) != visited.end());
 
-	auto [colors, discovery_times, finishing_times] = dfs_data;
-
 	for (auto& node : { &node1, &node2, &node3, &node4, &node5, &node6, &node7 }) {
-		BOOST_CHECK(colors[node] == CityColor::FINISHED);
+		BOOST_CHECK(dfs_data.getColor(Archadian.getId(*node)) == CityColor::FINISHED);
 	}
 
 	std::unordered_map<City*, std::size_t, CityHash, CityEqual> expected_discovery_times = {
@@ -133,11 +129,11 @@ BOOST_AUTO_TEST_CASE(DFS_ComplexArchadianTraversal) {
 
 	for (auto& node : { &node1, &node2, &node3, &node4, &node5, &node6, &node7 }) {
 		// Cada n deve ter tempos de descoberta e trmino definidos
-		BOOST_CHECK(discovery_times.find(node) != discovery_times.end());
-		BOOST_CHECK(finishing_times.find(node) != finishing_times.end());
+		CityId id = Archadian.getId(*node);
+		BOOST_CHECK(id != NO_CITY);
 
-		DiscoveryTime d_time = discovery_times[node];
-		FinishingTime f_time = finishing_times[node];
+		DiscoveryTime d_time = dfs_data.getDiscoveryTime(id);
+		FinishingTime f_time = dfs_data.getFinishingTime(id);
 
 		BOOST_CHECK(d_time < f_time);
 
@@ -178,13 +174,10 @@ BOOST_AUTO_TEST_CASE(DFS_DisconnectedArchadianTest) {
 	BOOST_CHECK(visited.find(node5) != visited.end());
 	BOOST_CHECK(visited.find(node6) != visited.end());
 
-	// Extrao dos dados retornados pelo DFS
-	auto [colors, discovery_times, finishing_times] = dfs_data;
-
 	// Verificao das cores dos ns aps o DFS
 	for (auto& node : { &node1, &node2, &node3, &node4, &node5, &node6 }) {
 		// O n deve estar marcado como "preto" aps a concluso do DFS
-		BOOST_CHECK(colors[node] == CityColor::FINISHED);
+		BOOST_CHECK(dfs_data.getColor(Archadian.getId(*node)) == CityColor::FINISHED);
 	}
 
 	// Tempos esperados de descoberta e trmino para cada n
@@ -210,11 +203,11 @@ BOOST_AUTO_TEST_CASE(DFS_DisconnectedArchadianTest) {
 	// Verificao dos tempos de descoberta e trmino
 	for (auto& node : { &node1, &node2, &node3, &node4, &node5, &node6 }) {
 		// Cada n deve ter tempos de descoberta e trmino definidos
-		BOOST_CHECK(discovery_times.find(node) != discovery_times.end());
-		BOOST_CHECK(finishing_times.find(node) != finishing_times.end());
+		CityId id = Archadian.getId(*node);
+		BOOST_CHECK(id != NO_CITY);
 
-		DiscoveryTime d_time = discovery_times[node];
-		FinishingTime f_time = finishing_times[node];
+		DiscoveryTime d_time = dfs_data.getDiscoveryTime(id);
+		FinishingTime f_time = dfs_data.getFinishingTime(id);
 
 		// O tempo de descoberta deve ser menor que o tempo de trmino
 		BOOST_CHECK(d_time < f_time);
@@ -223,4 +216,84 @@ BOOST_AUTO_TEST_CASE(DFS_DisconnectedArchadianTest) {
 		BOOST_CHECK(d_time == expected_discovery_times[node]);
 		BOOST_CHECK(f_time == expected_finishing_times[node]);
 	}
-}
\ No newline at end of file
+}
+
+// Teste do estado da DFS com cores empacotadas em 2 bits e reaproveitamento com reset
+BOOST_AUTO_TEST_CASE(DFS_TraversalStatePackedColors) {
+	TraversalState state(70);
+
+	for (CityId node = 0; node < 70; node++) {
+		BOOST_CHECK(state.getColor(node) == CityColor::UNDISCOVERED);
+		state.setColor(node, static_cast<CityColor>(node % 3));
+		state.setDiscoveryTime(node, node + 1);
+	}
+
+	for (CityId node = 0; node < 70; node++) {
+		BOOST_CHECK(state.getColor(node) == static_cast<CityColor>(node % 3));
+		BOOST_CHECK(state.getDiscoveryTime(node) == node + 1);
+	}
+
+	state.reset(40);
+
+	BOOST_CHECK(state.size() == 40);
+	for (CityId node = 0; node < 40; node++) {
+		BOOST_CHECK(state.getColor(node) == CityColor::UNDISCOVERED);
+		BOOST_CHECK(state.getDiscoveryTime(node) == 0);
+		BOOST_CHECK(state.getFinishingTime(node) == 0);
+	}
+}
+
+// Teste DFS em uma cadeia muito longa, que estouraria a pilha com uma DFS recursiva
+BOOST_AUTO_TEST_CASE(DFS_DeepChainIsStackSafe) {
+	const CityId n = 1000000;
+
+	std::vector<Edge> edges;
+	for (CityId node = 0; node + 1 < n; node++)
+		edges.push_back({ node, node + 1 });
+
+	Graph graph(n, edges);
+
+	std::vector<CityId> order(n);
+	for (CityId node = 0; node < n; node++)
+		order[node] = node;
+
+	TraversalState state;
+	Algorithms::DFS(graph, order, state);
+
+	BOOST_CHECK(state.getDiscoveryTime(0) == 1);
+	BOOST_CHECK(state.getFinishingTime(0) == 2 * n);
+	BOOST_CHECK(state.getDiscoveryTime(n - 1) == n);
+	BOOST_CHECK(state.getFinishingTime(n - 1) == n + 1);
+	BOOST_CHECK(state.getColor(n / 2) == CityColor::FINISHED);
+	BOOST_CHECK(state.getPostorder().size() == n);
+	BOOST_CHECK(state.getPostorder().front() == n - 1);
+	BOOST_CHECK(state.getPostorder().back() == 0);
+}
+
+// Teste da ps-ordem registrada pela DFS: todas as cidades, em ordem crescente de finalizao
+BOOST_AUTO_TEST_CASE(DFS_PostorderFollowsFinishingTime) {
+	Graph graph(6, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 1, 3 }, { 4, 5 }, { 5, 3 } });
+
+	TraversalState state;
+	Algorithms::DFS(graph, { 4, 0, 1, 2, 3, 5 }, state);
+
+	std::span<const CityId> postorder = state.getPostorder();
+	BOOST_REQUIRE(postorder.size() == 6);
+
+	std::vector<bool> seen(6, false);
+	for (std::size_t i = 0; i < postorder.size(); i++) {
+		BOOST_CHECK(!seen[postorder[i]]);
+		seen[postorder[i]] = true;
+		if (i > 0)
+			BOOST_CHECK(state.getFinishingTime(postorder[i - 1]) < state.getFinishingTime(postorder[i]));
+	}
+
+	// A primeira rvore comea em 4 e finaliza 3, 5 e 4, nessa ordem.
+	BOOST_CHECK(postorder[0] == 3);
+	BOOST_CHECK(postorder[1] == 5);
+	BOOST_CHECK(postorder[2] == 4);
+
+	// Reiniciar o estado esvazia a ps-ordem.
+	state.reset(6);
+	BOOST_CHECK(state.getPostorder().empty());
+}
@@ -1,8 +1,13 @@
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 #include "Archadian.h"
 #include "City.h"
 #include "Algorithms.h"
+#include "BucketQueue.h"
+#include "SearchWorkspace.h"
+#include "ShortestPathTree.h"
 
 // Teste do algoritmo de Dijkstra para calcular a distncia mnima
 BOOST_AUTO_TEST_CASE(Dijkstra_ShortestPath) {
@@ -14,12 +19,12 @@ BOOST_AUTO_TEST_CASE(Dijkstra_ShortestPath) {
 	node1.connect(&node3);
 	Archadian Archadian({ node1, node2, node3, node4 });
 
-	auto distances = Algorithms::Dijkstra(&Archadian, node1);
+	ShortestPathTree tree = Algorithms::Dijkstra(&Archadian, node1);
 
-	BOOST_CHECK(distances.find(&node1) == distances.end());
-	BOOST_CHECK(distances[&node2].size() == 1);
-	BOOST_CHECK(distances[&node3].size() == 1);
-	BOOST_CHECK(distances[&node4].size() == 2);
+	BOOST_CHECK(tree.distance(Archadian.getId(node1)) == 0 && tree.path(Archadian.getId(node1)).empty());
+	BOOST_CHECK(tree.hops(Archadian.getId(node2)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node3)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node4)) == 2);
 }
 
 // Teste complexo do algoritmo de Dijkstra para calcular a distncia mnima
@@ -38,14 +43,14 @@ BOOST_AUTO_TEST_CASE(Dijkstra_ComplexShortestPath) {
 
 	Archadian Archadian({ node1, node2, node3, node4, node5, node6 });
 
-	auto distances = Algorithms::Dijkstra(&Archadian, node1);
+	ShortestPathTree tree = Algorithms::Dijkstra(&Archadian, node1);
 
-	BOOST_CHECK(distances.find(&node1) == distances.end());
-	BOOST_CHECK(distances[&node2].size() == 1);
-	BOOST_CHECK(distances[&node3].size() == 1);
-	BOOST_CHECK(distances[&node4].size() == 2);
-	BOOST_CHECK(distances[&node5].size() == 2);
-	BOOST_CHECK(distances[&node6].size() == 1);
+	BOOST_CHECK(tree.distance(Archadian.getId(node1)) == 0 && tree.path(Archadian.getId(node1)).empty());
+	BOOST_CHECK(tree.hops(Archadian.getId(node2)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node3)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node4)) == 2);
+	BOOST_CHECK(tree.hops(Archadian.getId(node5)) == 2);
+	BOOST_CHECK(tree.hops(Archadian.getId(node6)) == 1);
 }
 
 // Teste do algoritmo de Dijkstra em um grafo com ciclos
@@ -60,12 +65,12 @@ BOOST_AUTO_TEST_CASE(Dijkstra_CycleArchadianTest) {
 
 	Archadian Archadian({ node1, node2, node3, node4 });
 
-	auto distances = Algorithms::Dijkstra(&Archadian, node1);
+	ShortestPathTree tree = Algorithms::Dijkstra(&Archadian, node1);
 
-	BOOST_CHECK(distances.find(&node1) == distances.end());
-	BOOST_CHECK(distances[&node2].size() == 1);
-	BOOST_CHECK(distances[&node3].size() == 2);
-	BOOST_CHECK(distances[&node4].size() == 3);
+	BOOST_CHECK(tree.distance(Archadian.getId(node1)) == 0 && tree.path(Archadian.getId(node1)).empty());
+	BOOST_CHECK(tree.hops(Archadian.getId(node2)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node3)) == 2);
+	BOOST_CHECK(tree.hops(Archadian.getId(node4)) == 3);
 }
 
 // Teste do algoritmo de Dijkstra em um grafo desconexo
@@ -79,12 +84,159 @@ BOOST_AUTO_TEST_CASE(Dijkstra_DisconnectedArchadianTest) {
 
 	Archadian Archadian({ node1, node2, node3, node4, node5 });
 
-	auto distances = Algorithms::Dijkstra(&Archadian, node1);
+	ShortestPathTree tree = Algorithms::Dijkstra(&Archadian, node1);
+
+	BOOST_CHECK(tree.distance(Archadian.getId(node1)) == 0 && tree.path(Archadian.getId(node1)).empty());
+	BOOST_CHECK(tree.hops(Archadian.getId(node2)) == 1);
+	BOOST_CHECK(tree.hops(Archadian.getId(node3)) == 2);
+
+	BOOST_CHECK(!tree.reaches(Archadian.getId(node4)));
+	BOOST_CHECK(!tree.reaches(Archadian.getId(node5)));
+}
+
+// Teste do algoritmo de Dijkstra com pesos, nos baldes e no heap usado para pesos grandes
+BOOST_AUTO_TEST_CASE(Dijkstra_WeightedRoads) {
+	// 0 -> 2  mais curto pelo desvio 0 -> 1 -> 2; 0 -> 3 direto e por 1 empatam em 4.
+	for (Weight scale : { Weight{ 1 }, BucketQueue::MAX_BUCKETS }) {
+		Graph graph(5, {
+			{ 0, 1, 1 * scale }, { 0, 2, 5 * scale }, { 1, 2, 1 * scale }, { 0, 3, 4 * scale },
+			{ 1, 3, 3 * scale }, { 2, 4, 1 * scale } });
+
+		ShortestPathTree tree = Algorithms::Dijkstra(graph, 0);
+
+		BOOST_CHECK(tree.path(0).empty());
+		BOOST_CHECK((tree.path(2) == std::vector<CityId>{ 1, 2 }));
+		BOOST_CHECK((tree.path(3) == std::vector<CityId>{ 3 }));
+		BOOST_CHECK((tree.path(4) == std::vector<CityId>{ 1, 2, 4 }));
+		BOOST_CHECK(tree.distance(4) == 3 * scale);
+	}
+}
+
+// Com os pesos multiplicados at passar de `MAX_BUCKETS`, o heap d as distncias dos baldes multiplicadas e os mesmos predecessores
+BOOST_AUTO_TEST_CASE(Dijkstra_HeapMatchesBuckets) {
+	std::mt19937 random(37);
+	const Weight scale = BucketQueue::MAX_BUCKETS + 1;
+
+	for (int round = 0; round < 50; round++) {
+		std::size_t n = 1 + random() % 40;
+		std::vector<Edge> edges, scaled;
+		for (std::size_t i = 1 + random() % (3 * n); i > 0; i--) {
+			Edge edge{ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n), static_cast<Weight>(1 + random() % 20) };
+			edges.push_back(edge);
+			scaled.push_back({ edge.source, edge.target, edge.weight * scale });
+		}
+		Graph buckets(n, edges), heap(n, scaled);
+		BOOST_REQUIRE(buckets.maxWeight() <= BucketQueue::MAX_BUCKETS && heap.maxWeight() > BucketQueue::MAX_BUCKETS);
+
+		for (CityId source = 0; source < n; source++) {
+			ShortestPathTree expected = Algorithms::Dijkstra(buckets, source);
+			ShortestPathTree tree = Algorithms::Dijkstra(heap, source);
+
+			for (CityId node = 0; node < n; node++) {
+				BOOST_REQUIRE(tree.reaches(node) == expected.reaches(node));
+				if (!tree.reaches(node) || node == source) continue;
+				BOOST_REQUIRE(tree.distance(node) == expected.distance(node) * scale);
+				BOOST_REQUIRE(tree.parent(node) == expected.parent(node));
+			}
+		}
+	}
+}
+
+// Um mesmo espao de busca reaproveitado entre origens d os mesmos caminhos de uma busca nova
+BOOST_AUTO_TEST_CASE(Dijkstra_ReusedWorkspace) {
+	std::mt19937 random(23);
+	SearchWorkspace workspace;
+
+	for (int round = 0; round < 50; round++) {
+		std::size_t n = 1 + random() % 25;
+		std::vector<Edge> edges;
+		for (std::size_t i = random() % (3 * n); i > 0; i--)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n),
+				static_cast<Weight>(1 + random() % (round % 2 == 0 ? 1 : 6)) });
+		Graph graph(n, edges);
+
+		for (CityId source = 0; source < n; source++) {
+			ShortestPathTree tree = Algorithms::Dijkstra(graph, source);
+			Algorithms::Dijkstra(graph, source, workspace);
+
+			// S as cidades alcanadas por esta busca aparecem como alcanadas.
+			std::size_t reached = 0;
+			for (CityId node = 0; node < n; node++) {
+				if (node == source) continue;
+				BOOST_REQUIRE(workspace.reached(node) == tree.reaches(node));
+				if (!workspace.reached(node)) continue;
+
+				reached++;
+				BOOST_REQUIRE(workspace.settled(node));
+				BOOST_REQUIRE(workspace.parent(node) == tree.parent(node));
+				BOOST_REQUIRE(workspace.distance(node) == tree.distance(node));
+			}
+			BOOST_REQUIRE(workspace.touched().size() == reached + 1);
+		}
+	}
+}
+
+// Os caminhos da rvore so percorridos sob demanda, do destino at a origem
+BOOST_AUTO_TEST_CASE(Dijkstra_TreeWalk) {
+	// 0 -> 1 -> 2 -> 3 e 0 -> 2; a cidade 4 no  alcanada.
+	Graph graph(5, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 0, 2 }, { 4, 0 } });
+	ShortestPathTree tree = Algorithms::Dijkstra(graph, 0);
+
+	BOOST_CHECK(tree.source() == 0 && tree.size() == 5);
+	BOOST_CHECK(tree.distance(3) == 2 && tree.hops(3) == 2 && tree.parent(3) == 2);
 
-	BOOST_CHECK(distances.find(&node1) == distances.end());
-	BOOST_CHECK(distances[&node2].size() == 1);
-	BOOST_CHECK(distances[&node3].size() == 2);
+	std::vector<CityId> walked(tree.walk(3).begin(), tree.walk(3).end());
+	BOOST_CHECK((walked == std::vector<CityId>{ 3, 2, 0 }));
+	BOOST_CHECK((tree.path(3) == std::vector<CityId>{ 2, 3 }));
 
-	BOOST_CHECK(distances.find(&node4) == distances.end());
-	BOOST_CHECK(distances.find(&node5) == distances.end());
-}
\ No newline at end of file
+	BOOST_CHECK(!tree.reaches(4) && tree.distance(4) == SearchWorkspace::UNREACHED && tree.hops(4) == 0);
+	BOOST_CHECK(tree.walk(4).begin() == tree.walk(4).end());
+	BOOST_CHECK(tree.path(4).empty());
+
+	// Uma origem fora do grafo d uma rvore vazia.
+	BOOST_CHECK(!ShortestPathTree().reaches(0));
+}
+
+// A busca a partir das duas pontas encontra um caminho com a distncia do Dijkstra
+BOOST_AUTO_TEST_CASE(Dijkstra_Bidirectional) {
+	std::mt19937 random(29);
+	SearchWorkspace forward, backward;
+	std::vector<CityId> path;
+
+	for (int round = 0; round < 60; round++) {
+		std::size_t n = 1 + random() % 30;
+		Weight maxWeight = round % 3 == 0 ? 1 : (round % 3 == 1 ? 7 : 10000);
+		std::vector<Edge> edges;
+		for (std::size_t i = random() % (3 * n); i > 0; i--)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n),
+				static_cast<Weight>(1 + random() % maxWeight) });
+		Graph graph(n, edges);
+		Graph reverse = graph.transpose();
+
+		for (CityId source = 0; source < n; source++) {
+			ShortestPathTree tree = Algorithms::Dijkstra(graph, source);
+
+			for (CityId target = 0; target < n; target++) {
+				bool found = Algorithms::ShortestPath(graph, reverse, source, target, forward, backward, path);
+				BOOST_REQUIRE(found == tree.reaches(target));
+				if (!found) {
+					BOOST_REQUIRE(path.empty());
+					continue;
+				}
+
+				// O caminho liga a origem ao destino pelas estradas do grafo, com o peso mais curto.
+				BOOST_REQUIRE(path.front() == source && path.back() == target);
+				Distance length = 0;
+				for (std::size_t i = 0; i + 1 < path.size(); i++) {
+					Weight lightest = 0;
+					for (EdgeIndex edge = graph.begin(path[i]); edge < graph.end(path[i]); edge++)
+						if (graph.target(edge) == path[i + 1] && (lightest == 0 || graph.weight(edge) < lightest))
+							lightest = graph.weight(edge);
+					BOOST_REQUIRE(lightest != 0);
+					length += lightest;
+				}
+				BOOST_REQUIRE(length == tree.distance(target));
+			}
+		}
+	}
+}
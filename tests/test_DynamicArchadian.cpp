@@ -0,0 +1,205 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "Algorithms.h"
+#include "CapitalFinder.h"
+#include "DynamicArchadian.h"
+
+namespace {
+	Archadian buildArchadian(std::size_t size, const std::vector<Edge>& edges) {
+		NameTable names;
+		std::vector<City> cities;
+		for (std::size_t i = 0; i < size; i++)
+			cities.push_back(City(i + 1, names.add("c" + std::to_string(i))));
+
+		return Archadian(std::move(cities), Graph(size, edges), std::move(names));
+	}
+
+	/**
+	 * Compara as componentes mantidas com as recalculadas do zero e verifica a ordem topolgica e as patrulhas.
+	 */
+	void checkAgainstPearce(DynamicArchadian& dynamic, const std::vector<Edge>& edges) {
+		Graph graph(dynamic.size(), edges);
+		std::vector<CityId> order(dynamic.size());
+		for (CityId node = 0; node < order.size(); node++) order[node] = node;
+		Components expected = Algorithms::Pearce(graph, order);
+
+		BOOST_REQUIRE(dynamic.componentCount() == expected.count());
+		for (const Edge& edge : edges) {
+			bool same = expected.componentOf(edge.source) == expected.componentOf(edge.target);
+			BOOST_REQUIRE(same == (dynamic.componentOf(edge.source) == dynamic.componentOf(edge.target)));
+		}
+		for (ComponentId component = 0; component < expected.count(); component++)
+			for (CityId node : expected.members(component))
+				BOOST_REQUIRE(dynamic.componentOf(node) == dynamic.componentOf(expected.root(component)));
+
+		std::vector<ComponentId> components = dynamic.getComponents();
+		BOOST_REQUIRE(components.size() == expected.count());
+		std::vector<std::size_t> position(components.size() + dynamic.size());
+		for (std::size_t i = 0; i < components.size(); i++) position[components[i]] = i;
+		for (const Edge& edge : edges)
+			BOOST_REQUIRE(position[dynamic.componentOf(edge.source)] <= position[dynamic.componentOf(edge.target)]);
+
+		CityId capital = dynamic.getCapital();
+		for (ComponentId component : components) {
+			std::span<const CityId> members = dynamic.getMembers(component);
+			BOOST_REQUIRE(dynamic.componentOf(dynamic.getRepresentative(component)) == component);
+
+			Patrolling patrol = dynamic.getPatrolling(component);
+			if (members.size() == 1) {
+				BOOST_REQUIRE(patrol.empty());
+				continue;
+			}
+			bool home = capital != NO_CITY && dynamic.componentOf(capital) == component;
+			BOOST_REQUIRE(patrol[0] == (home ? capital : dynamic.getRepresentative(component)));
+			for (CityId node : members)
+				BOOST_REQUIRE(std::find(patrol.begin(), patrol.end(), node) != patrol.end());
+		}
+	}
+}
+
+// Sem mudanas, o modo incremental tem os mesmos batalhes e patrulhas do Archadian
+BOOST_AUTO_TEST_CASE(DynamicArchadian_MatchesArchadian) {
+	std::vector<Edge> edges = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 }, { 3, 4 }, { 4, 3 }, { 4, 5 }, { 1, 6 }, { 6, 5 } };
+	Archadian archadian = buildArchadian(7, edges);
+	archadian.calcCapital();
+	archadian.calcBattalionsAndPatrolling();
+
+	DynamicArchadian dynamic(archadian);
+	BOOST_CHECK(dynamic.getCapital() == archadian.getCapital());
+
+	std::vector<CityId> battalions = dynamic.getBattalions();
+	Battalions expected = archadian.getBattalions();
+	BOOST_CHECK_EQUAL_COLLECTIONS(battalions.begin(), battalions.end(), expected.begin(), expected.end());
+
+	std::size_t patrol = 0;
+	for (ComponentId component : dynamic.getComponents()) {
+		if (dynamic.getMembers(component).size() < 2) continue;
+		BOOST_REQUIRE(patrol < archadian.getPatrolCount());
+
+		Patrolling route = dynamic.getPatrolling(component);
+		Patrolling expectedRoute = archadian.getPatrolling(patrol++);
+		BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), expectedRoute.begin(), expectedRoute.end());
+	}
+	BOOST_CHECK(patrol == archadian.getPatrolCount());
+
+	BOOST_CHECK(dynamic.findCity("c4") == 4);
+	BOOST_CHECK(dynamic.findCity("c9") == NO_CITY);
+}
+
+// Um ciclo fechado une as componentes no caminho; fech-lo de novo as separa
+BOOST_AUTO_TEST_CASE(DynamicArchadian_MergeAndSplit) {
+	// 0 -> 1 -> 2 -> 3, e 4 isolada.
+	std::vector<Edge> edges = { { 0, 1 }, { 1, 2 }, { 2, 3 } };
+	Archadian archadian = buildArchadian(5, edges);
+	DynamicArchadian dynamic(archadian);
+	BOOST_CHECK(dynamic.componentCount() == 5);
+
+	dynamic.addRoad(2, 1);
+	BOOST_CHECK(dynamic.componentCount() == 4);
+	BOOST_CHECK(dynamic.componentOf(1) == dynamic.componentOf(2));
+
+	dynamic.addRoad(3, 0);
+	BOOST_CHECK(dynamic.componentCount() == 2);
+	ComponentId merged = dynamic.componentOf(0);
+	BOOST_CHECK(dynamic.getMembers(merged).size() == 4);
+	BOOST_CHECK(dynamic.getPatrolling(merged).size() >= 4);
+
+	// Fechar uma estrada paralela a outra no separa nada.
+	dynamic.addRoad(0, 1);
+	BOOST_CHECK(dynamic.removeRoad(0, 1));
+	BOOST_CHECK(dynamic.componentCount() == 2);
+	BOOST_CHECK(!dynamic.removeRoad(0, 4));
+
+	BOOST_CHECK(dynamic.removeRoad(3, 0));
+	BOOST_CHECK(dynamic.componentCount() == 4);
+	BOOST_CHECK(dynamic.componentOf(1) == dynamic.componentOf(2));
+	BOOST_CHECK(dynamic.componentOf(0) != dynamic.componentOf(3));
+
+	// O representante de uma parte separada  a sua menor cidade.
+	BOOST_CHECK(dynamic.getRepresentative(dynamic.componentOf(2)) == 1);
+
+	CityId added = dynamic.addCity("novo");
+	BOOST_CHECK(added == 5);
+	BOOST_CHECK(dynamic.findCity("novo") == 5);
+	dynamic.addRoad(4, added);
+	dynamic.addRoad(added, 4);
+	BOOST_CHECK(dynamic.componentOf(4) == dynamic.componentOf(added));
+	BOOST_CHECK(dynamic.getName(added) == "novo");
+}
+
+// A capital pode acabar em uma componente representada por outra cidade: ela no recebe batalho, e a
+// patrulha comea pela capital, como em um clculo do zero
+BOOST_AUTO_TEST_CASE(DynamicArchadian_CapitalInMergedComponent) {
+	// 0 -> 1 -> 2: a capital  0, e cada cidade representa a sua prpria componente.
+	Archadian archadian = buildArchadian(3, { { 0, 1 }, { 1, 2 } });
+	archadian.calcCapital();
+	DynamicArchadian dynamic(archadian);
+	BOOST_REQUIRE(dynamic.getCapital() == 0);
+
+	// A unio de {1} e {2} fica com o representante 1; com a estrada 2 -> 0, a capital passa a ser 2.
+	BOOST_REQUIRE(dynamic.removeRoad(0, 1));
+	dynamic.addRoad(2, 1);
+	dynamic.addRoad(2, 0);
+	std::vector<Edge> edges = { { 1, 2 }, { 2, 1 }, { 2, 0 } };
+
+	ComponentId merged = dynamic.componentOf(2);
+	BOOST_REQUIRE(dynamic.componentOf(1) == merged);
+	BOOST_REQUIRE(dynamic.getRepresentative(merged) == 1);
+	BOOST_CHECK(dynamic.getCapital() == 2);
+
+	Archadian expected = buildArchadian(3, edges);
+	expected.calcCapital();
+	expected.calcBattalionsAndPatrolling();
+	BOOST_REQUIRE(expected.getCapital() == 2);
+
+	std::vector<CityId> battalions = dynamic.getBattalions();
+	Battalions expectedBattalions = expected.getBattalions();
+	BOOST_CHECK_EQUAL_COLLECTIONS(battalions.begin(), battalions.end(), expectedBattalions.begin(), expectedBattalions.end());
+
+	BOOST_REQUIRE(expected.getPatrolCount() == 1);
+	Patrolling route = dynamic.getPatrolling(merged);
+	Patrolling expectedRoute = expected.getPatrolling(0);
+	BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), expectedRoute.begin(), expectedRoute.end());
+	BOOST_CHECK(route[0] == 2);
+}
+
+// Uma sequncia aleatria de aberturas e fechamentos mantm as mesmas componentes de um reclculo completo
+BOOST_AUTO_TEST_CASE(DynamicArchadian_RandomUpdates) {
+	std::mt19937 random(11);
+	const CityId size = 60;
+
+	std::vector<Edge> edges;
+	std::uniform_int_distribution<CityId> city(0, size - 1);
+	for (int i = 0; i < 70; i++)
+		edges.push_back({ city(random), city(random) });
+
+	Archadian archadian = buildArchadian(size, edges);
+	archadian.calcCapital();
+	DynamicArchadian dynamic(archadian);
+	checkAgainstPearce(dynamic, edges);
+
+	for (int step = 0; step < 400; step++) {
+		if (edges.empty() || random() % 3 != 0) {
+			Edge edge = { city(random), city(random) };
+			edges.push_back(edge);
+			dynamic.addRoad(edge.source, edge.target);
+		}
+		else {
+			std::size_t index = random() % edges.size();
+			Edge edge = edges[index];
+			edges.erase(edges.begin() + static_cast<std::ptrdiff_t>(index));
+			BOOST_REQUIRE(dynamic.removeRoad(edge.source, edge.target));
+		}
+
+		checkAgainstPearce(dynamic, edges);
+
+		if (step % 50 == 0) {
+			Graph graph(size, edges);
+			BOOST_CHECK(dynamic.getCapital() == CapitalFinder(graph).find());
+		}
+	}
+}
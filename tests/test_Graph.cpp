@@ -0,0 +1,94 @@
+#include <boost/test/unit_test.hpp>
+
+#include "Archadian.h"
+#include "City.h"
+#include "Graph.h"
+#include "Algorithms.h"
+
+// Teste da construo do grafo CSR a partir de uma lista de arestas
+BOOST_AUTO_TEST_CASE(Graph_BuildFromEdges) {
+	Graph graph(4, { { 2, 3 }, { 0, 1 }, { 0, 2 }, { 2, 0 }, { 0, 3 } });
+
+	BOOST_CHECK(graph.size() == 4);
+	BOOST_CHECK(graph.edgeCount() == 5);
+	BOOST_CHECK(!graph.isWeighted());
+
+	// As estradas de uma mesma origem mantm a ordem de insero.
+	std::vector<CityId> expected0 = { 1, 2, 3 };
+	std::vector<CityId> expected2 = { 3, 0 };
+	auto neighbors0 = graph.neighbors(0);
+	auto neighbors2 = graph.neighbors(2);
+
+	BOOST_CHECK(std::vector<CityId>(neighbors0.begin(), neighbors0.end()) == expected0);
+	BOOST_CHECK(graph.neighbors(1).empty());
+	BOOST_CHECK(std::vector<CityId>(neighbors2.begin(), neighbors2.end()) == expected2);
+	BOOST_CHECK(graph.neighbors(3).empty());
+}
+
+// Teste da transposio do grafo CSR
+BOOST_AUTO_TEST_CASE(Graph_Transpose) {
+	Graph graph(3, { { 0, 1 }, { 1, 2 }, { 2, 1 }, { 0, 2 } });
+	Graph transposed = graph.transpose();
+
+	BOOST_CHECK(transposed.size() == 3);
+	BOOST_CHECK(transposed.edgeCount() == 4);
+
+	std::vector<CityId> expected1 = { 0, 2 };
+	std::vector<CityId> expected2 = { 0, 1 };
+	auto neighbors1 = transposed.neighbors(1);
+	auto neighbors2 = transposed.neighbors(2);
+
+	BOOST_CHECK(transposed.neighbors(0).empty());
+	BOOST_CHECK(std::vector<CityId>(neighbors1.begin(), neighbors1.end()) == expected1);
+	BOOST_CHECK(std::vector<CityId>(neighbors2.begin(), neighbors2.end()) == expected2);
+}
+
+// Teste da construo do grafo a partir das cidades, descartando estradas para fora do conjunto
+BOOST_AUTO_TEST_CASE(Graph_FromCities) {
+	City node1(1), node2(2), node3(3), node4(4);
+
+	node1.connect(&node2);
+	node2.connect(&node3);
+	node3.connect(&node4);
+	node3.connect(&node1);
+
+	Graph graph = Graph::fromCities({ node3, node1, node2 });
+
+	BOOST_CHECK(graph.size() == 3);
+	BOOST_CHECK(graph.edgeCount() == 3);
+
+	// node3 -> node1, node1 -> node2, node2 -> node3
+	BOOST_CHECK(graph.neighbors(0).size() == 1 && graph.neighbors(0)[0] == 1);
+	BOOST_CHECK(graph.neighbors(1).size() == 1 && graph.neighbors(1)[0] == 2);
+	BOOST_CHECK(graph.neighbors(2).size() == 1 && graph.neighbors(2)[0] == 0);
+}
+
+// Teste das estradas com peso
+BOOST_AUTO_TEST_CASE(Graph_Weights) {
+	Graph graph(3, { { 0, 1, 4 }, { 0, 2, 1 }, { 2, 1, 2 } });
+
+	BOOST_CHECK(graph.isWeighted());
+	BOOST_CHECK(graph.weight(graph.begin(0)) == 4);
+	BOOST_CHECK(graph.weight(graph.begin(0) + 1) == 1);
+	BOOST_CHECK(graph.weight(graph.begin(2)) == 2);
+
+	ShortestPathTree tree = Algorithms::Dijkstra(graph, 0);
+
+	BOOST_CHECK(tree.path(0).empty());
+	BOOST_CHECK(tree.path(1) == std::vector<CityId>({ 2, 1 }));
+	BOOST_CHECK(tree.path(2) == std::vector<CityId>({ 2 }));
+	BOOST_CHECK(tree.distance(1) == 3);
+}
+
+// Teste do Kosaraju executado diretamente sobre o grafo CSR
+BOOST_AUTO_TEST_CASE(Graph_Kosaraju) {
+	Graph graph(5, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 1, 3 }, { 3, 4 }, { 4, 3 } });
+
+	auto sccs = Algorithms::Kosaraju(graph, { 0, 1, 2, 3, 4 });
+
+	BOOST_CHECK(sccs.size() == 2);
+	BOOST_CHECK(sccs[0][0] == 0);
+	BOOST_CHECK(sccs[0].size() == 3);
+	BOOST_CHECK(sccs[1][0] == 3);
+	BOOST_CHECK(sccs[1].size() == 2);
+}
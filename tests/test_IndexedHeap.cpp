@@ -0,0 +1,70 @@
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "IndexedHeap.h"
+
+// Diminuir a distncia move a cidade no lugar, sem uma segunda entrada
+BOOST_AUTO_TEST_CASE(IndexedHeap_DecreaseKey) {
+	IndexedHeap heap(4);
+	BOOST_CHECK(heap.push(0, 10));
+	BOOST_CHECK(heap.push(1, 5));
+	BOOST_CHECK(heap.push(2, 7));
+
+	BOOST_CHECK(heap.push(0, 3));
+	BOOST_CHECK(!heap.push(2, 9));
+	BOOST_CHECK(!heap.push(1, 5));
+	BOOST_CHECK(heap.size() == 3);
+	BOOST_CHECK(heap.contains(0) && !heap.contains(3));
+
+	// Cidades fora do tamanho reservado fazem o ndice crescer; empates saem pelo identificador.
+	BOOST_CHECK(heap.push(100, 7));
+
+	Distance distance;
+	BOOST_CHECK(heap.pop(distance) == 0 && distance == 3);
+	BOOST_CHECK(heap.pop(distance) == 1 && distance == 5);
+	BOOST_CHECK(heap.pop(distance) == 2 && distance == 7);
+	BOOST_CHECK(heap.pop(distance) == 100 && distance == 7);
+	BOOST_CHECK(heap.empty() && !heap.contains(0));
+
+	heap.push(3, 1);
+	heap.clear();
+	BOOST_CHECK(heap.empty() && !heap.contains(3));
+	BOOST_CHECK(heap.push(3, 2));
+}
+
+// Inseres, diminuies e retiradas aleatrias seguem um conjunto ordenado
+BOOST_AUTO_TEST_CASE(IndexedHeap_MatchesOrderedSet) {
+	std::mt19937 random(3);
+	const CityId size = 200;
+
+	IndexedHeap heap(size);
+	std::set<std::pair<Distance, CityId>> expected;
+	std::vector<Distance> current(size, 0);
+
+	for (int step = 0; step < 20000; step++) {
+		if (random() % 3 == 0 && !expected.empty()) {
+			Distance distance;
+			CityId node = heap.pop(distance);
+			BOOST_REQUIRE(std::make_pair(distance, node) == *expected.begin());
+			expected.erase(expected.begin());
+			continue;
+		}
+
+		CityId node = static_cast<CityId>(random() % size);
+		Distance distance = random() % 1000;
+		bool present = expected.count({ current[node], node }) != 0;
+		bool improves = !present || distance < current[node];
+
+		BOOST_REQUIRE(heap.push(node, distance) == improves);
+		if (improves) {
+			if (present) expected.erase({ current[node], node });
+			expected.insert({ distance, node });
+			current[node] = distance;
+		}
+		BOOST_REQUIRE(heap.size() == expected.size());
+	}
+}
@@ -0,0 +1,120 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+#include "MapReader.h"
+
+namespace {
+	const std::string MAP = "4 5\nAlfa Beta\nBeta Gama\r\nGama Alfa\n  Delta\tBeta\nAlfa Delta";
+
+	void checkMap(const MapReader& reader) {
+		BOOST_CHECK(reader.cityCount() == 4);
+
+		BOOST_REQUIRE(reader.names().size() == 4);
+		BOOST_CHECK(reader.names()[0] == "Alfa");
+		BOOST_CHECK(reader.names()[1] == "Beta");
+		BOOST_CHECK(reader.names()[2] == "Gama");
+		BOOST_CHECK(reader.names()[3] == "Delta");
+
+		BOOST_REQUIRE(reader.edges().size() == 5);
+		BOOST_CHECK(reader.edges()[0].source == 0 && reader.edges()[0].target == 1);
+		BOOST_CHECK(reader.edges()[2].source == 2 && reader.edges()[2].target == 0);
+		BOOST_CHECK(reader.edges()[3].source == 3 && reader.edges()[3].target == 1);
+		BOOST_CHECK(reader.edges()[4].source == 0 && reader.edges()[4].target == 3);
+		BOOST_CHECK(reader.edges()[4].weight == 1);
+	}
+}
+
+// Um arquivo regular  mapeado na memria
+BOOST_AUTO_TEST_CASE(MapReader_MappedFile) {
+	std::FILE* file = std::tmpfile();
+	std::fputs(MAP.c_str(), file);
+	std::fflush(file);
+
+	MapReader reader(fileno(file));
+	BOOST_CHECK(reader.isMapped());
+	BOOST_CHECK(reader.parse());
+	checkMap(reader);
+
+	std::fclose(file);
+}
+
+// Um pipe no pode ser mapeado e  lido para um buffer
+BOOST_AUTO_TEST_CASE(MapReader_Pipe) {
+	int fds[2];
+	BOOST_REQUIRE(pipe(fds) == 0);
+	BOOST_REQUIRE(write(fds[1], MAP.data(), MAP.size()) == static_cast<ssize_t>(MAP.size()));
+	close(fds[1]);
+
+	MapReader reader(fds[0]);
+	BOOST_CHECK(!reader.isMapped());
+	BOOST_CHECK(reader.parse());
+	checkMap(reader);
+
+	close(fds[0]);
+}
+
+// Mais cidades do que o declarado fazem a tabela de nomes crescer, e uma entrada incompleta  rejeitada
+BOOST_AUTO_TEST_CASE(MapReader_GrowsAndDetectsTruncation) {
+	std::string map = "1 100\n";
+	for (int i = 0; i < 100; i++)
+		map += "c" + std::to_string(i) + " c" + std::to_string(i + 1) + "\n";
+
+	int fds[2];
+	BOOST_REQUIRE(pipe(fds) == 0);
+	BOOST_REQUIRE(write(fds[1], map.data(), map.size()) == static_cast<ssize_t>(map.size()));
+	close(fds[1]);
+
+	MapReader reader(fds[0]);
+	BOOST_CHECK(reader.parse());
+	BOOST_CHECK(reader.names().size() == 101);
+	for (CityId id = 0; id < 101; id++)
+		BOOST_CHECK(reader.names()[id] == "c" + std::to_string(id));
+	BOOST_CHECK(reader.edges()[99].source == 99 && reader.edges()[99].target == 100);
+	close(fds[0]);
+
+	BOOST_REQUIRE(pipe(fds) == 0);
+	std::string truncated = "2 2\nAlfa Beta\nBeta";
+	BOOST_REQUIRE(write(fds[1], truncated.data(), truncated.size()) == static_cast<ssize_t>(truncated.size()));
+	close(fds[1]);
+
+	MapReader incomplete(fds[0]);
+	BOOST_CHECK(!incomplete.parse());
+	close(fds[0]);
+}
+
+// Um terceiro campo na linha da estrada  o seu peso; pesos nulos ou invlidos so rejeitados
+BOOST_AUTO_TEST_CASE(MapReader_Weights) {
+	std::FILE* file = std::tmpfile();
+	std::fputs("3 4\nAlfa Beta 4\nBeta Gama\r\nGama Alfa\t7 \nAlfa Gama\n", file);
+	std::fflush(file);
+
+	MapReader reader(fileno(file));
+	BOOST_REQUIRE(reader.parse());
+	BOOST_REQUIRE(reader.edges().size() == 4);
+	BOOST_CHECK(reader.edges()[0].weight == 4);
+	BOOST_CHECK(reader.edges()[1].weight == 1);
+	BOOST_CHECK(reader.edges()[2].weight == 7);
+	BOOST_CHECK(reader.edges()[3].source == 0 && reader.edges()[3].target == 2 && reader.edges()[3].weight == 1);
+	std::fclose(file);
+
+	Weight weight = 0;
+	BOOST_CHECK(MapReader::parseWeight("12", weight) && weight == 12);
+	BOOST_CHECK(!MapReader::parseWeight("0", weight));
+	BOOST_CHECK(!MapReader::parseWeight("-3", weight));
+	BOOST_CHECK(!MapReader::parseWeight("3x", weight));
+	BOOST_CHECK(!MapReader::parseWeight("99999999999", weight));
+
+	for (const char* map : { "2 1\nAlfa Beta 0\n", "2 1\nAlfa Beta pesado\n" }) {
+		std::FILE* invalid = std::tmpfile();
+		std::fputs(map, invalid);
+		std::fflush(invalid);
+
+		MapReader rejected(fileno(invalid));
+		BOOST_CHECK(!rejected.parse());
+		std::fclose(invalid);
+	}
+}
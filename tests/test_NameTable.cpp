@@ -0,0 +1,47 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include "City.h"
+#include "NameTable.h"
+
+// Os nomes ficam na tabela e as cidades guardam apenas o identificador
+BOOST_AUTO_TEST_CASE(NameTable_AddAndGet) {
+	NameTable names;
+	BOOST_CHECK(names.size() == 0);
+
+	NameId rabanastre = names.add("Rabanastre");
+	NameId empty = names.add("");
+	NameId archades = names.add("Archades");
+
+	BOOST_CHECK(names.size() == 3);
+	BOOST_CHECK(rabanastre == 0 && empty == 1 && archades == 2);
+	BOOST_CHECK(names.get(rabanastre) == "Rabanastre");
+	BOOST_CHECK(names.get(empty).empty());
+	BOOST_CHECK(names.get(archades) == "Archades");
+	BOOST_CHECK(names.get(NO_NAME).empty());
+
+	City city(1, archades);
+	City copy = city;
+	BOOST_CHECK(copy.getNameId() == archades);
+	BOOST_CHECK(names.get(copy.getNameId()) == "Archades");
+	BOOST_CHECK(City(2).getNameId() == NO_NAME);
+}
+
+
+// A busca por nome enxerga os nomes acrescentados antes e depois de o ndice ser construdo
+BOOST_AUTO_TEST_CASE(NameTable_Find) {
+	NameTable names;
+	for (int i = 0; i < 20; i++)
+		names.add("c" + std::to_string(i));
+
+	BOOST_CHECK(names.find("c7") == 7);
+	BOOST_CHECK(names.find("c20") == NO_NAME);
+
+	for (int i = 20; i < 100; i++)
+		names.add("c" + std::to_string(i));
+
+	for (int i = 0; i < 100; i++)
+		BOOST_CHECK(names.find("c" + std::to_string(i)) == static_cast<NameId>(i));
+	BOOST_CHECK(names.find("") == NO_NAME);
+}
@@ -0,0 +1,148 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+#include "Algorithms.h"
+#include "PatrolBuilder.h"
+
+// A patrulha percorre a componente pelas estradas, no sentido em que podem ser trafegadas, e volta at a raiz
+BOOST_AUTO_TEST_CASE(Patrol_WalkAndReturn) {
+	// Componente {0, 1, 2, 3} e a cidade 4, que no faz parte dela.
+	Graph graph(5, { { 0, 1 }, { 1, 0 }, { 0, 2 }, { 2, 3 }, { 3, 1 }, { 4, 0 } });
+	Components components = Algorithms::Pearce(graph, { 0, 1, 2, 3, 4 });
+	BOOST_REQUIRE(components.count() == 2);
+	BOOST_REQUIRE(components.root(components.componentOf(0)) == 0);
+
+	Graph transposed = graph.transpose();
+	PatrolBuilder builder(graph, transposed, components);
+
+	std::vector<CityId> patrol;
+	builder.build(components.componentOf(0), patrol);
+
+	// DFS: 0, 1, volta para 0, 2, 3. Volta de 3 at a raiz: 3 -> 1 -> 0.
+	BOOST_CHECK((patrol == std::vector<CityId>{ 0, 1, 0, 2, 3, 1 }));
+
+	// Aqui toda cidade da rota, e a raiz depois da ltima,  destino de uma estrada que sai da anterior:
+	// at a volta da DFS de 1 para 0  uma estrada.
+	for (std::size_t i = 0; i < patrol.size(); i++) {
+		auto neighbors = graph.neighbors(patrol[i]);
+		CityId next = patrol[(i + 1) % patrol.size()];
+		BOOST_CHECK(std::find(neighbors.begin(), neighbors.end(), next) != neighbors.end());
+	}
+}
+
+// As estradas para fora da componente so ignoradas, e o construtor  reaproveitado entre componentes
+BOOST_AUTO_TEST_CASE(Patrol_ComponentMask) {
+	// {0, 1} -> {2, 3, 4}
+	Graph graph(5, { { 0, 1 }, { 1, 0 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 2 }, { 0, 4 } });
+	Components components = Algorithms::Pearce(graph, { 0, 1, 2, 3, 4 });
+	BOOST_REQUIRE(components.count() == 2);
+
+	Graph transposed = graph.transpose();
+	PatrolBuilder builder(graph, transposed, components);
+
+	std::vector<CityId> first, second;
+	builder.build(0, first);
+	builder.build(1, second);
+
+	BOOST_CHECK((first == std::vector<CityId>{ 0, 1 }));
+
+	// Raiz 2: 2 -> 3 -> 4, e de 4 de volta para 2.
+	BOOST_CHECK(second.front() == components.root(1));
+	BOOST_CHECK((second == std::vector<CityId>{ 2, 3, 4 }));
+}
+
+// Com pesos, a volta at a raiz  o caminho de menor peso, e no o de menos estradas
+BOOST_AUTO_TEST_CASE(Patrol_WeightedReturn) {
+	// Estradas 0 -> 1, 1 -> 0, 1 -> 2, 2 -> 1 e 2 -> 0, a mais pesada.
+	for (Weight heavy : { Weight{ 1 }, Weight{ 10 } }) {
+		Graph graph(3, { { 0, 1 }, { 1, 0 }, { 1, 2 }, { 2, 1 }, { 2, 0, heavy } });
+		Components components = Algorithms::Pearce(graph, { 0, 1, 2 });
+		BOOST_REQUIRE(components.count() == 1 && components.root(0) == 0);
+
+		Graph transposed = graph.transpose();
+		PatrolBuilder builder(graph, transposed, components);
+
+		std::vector<CityId> patrol;
+		builder.build(0, patrol);
+
+		// DFS: 0, 1, 2. Sem pesos, 2 volta direto para 0; com pesos, 2 -> 1 -> 0 custa 2 em vez de 10.
+		if (heavy == 1) BOOST_CHECK((patrol == std::vector<CityId>{ 0, 1, 2 }));
+		else BOOST_CHECK((patrol == std::vector<CityId>{ 0, 1, 2, 1 }));
+	}
+}
+
+// A volta buscada a partir das duas pontas  a mesma da busca por nveis a partir da ltima cidade
+BOOST_AUTO_TEST_CASE(Patrol_BidirectionalReturn) {
+	std::mt19937 random(31);
+
+	for (int round = 0; round < 200; round++) {
+		std::size_t n = 2 + random() % 40;
+		std::vector<Edge> edges;
+		for (std::size_t i = random() % (3 * n); i > 0; i--)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n) });
+		Graph graph(n, edges);
+		Graph transposed = graph.transpose();
+
+		std::vector<CityId> order(n);
+		for (CityId node = 0; node < n; node++) order[node] = node;
+		Components components = Algorithms::Pearce(graph, order);
+		PatrolBuilder builder(graph, transposed, components);
+
+		for (ComponentId component = 0; component < components.count(); component++) {
+			if (components.size(component) < 2) continue;
+			const CityId root = components.root(component);
+
+			// Ordem de desempate: a ordem de descoberta de uma DFS pelas estradas invertidas a partir da raiz.
+			std::vector<std::uint32_t> order(n, UINT32_MAX);
+			std::uint32_t discovered = 0;
+			auto visit = [&](auto& self, CityId node) -> void {
+				order[node] = discovered++;
+				for (CityId source : transposed.neighbors(node))
+					if (components.componentOf(source) == component && order[source] == UINT32_MAX) self(self, source);
+			};
+			visit(visit, root);
+			auto rank = [&](CityId node) { return order[node]; };
+
+			std::vector<CityId> patrol;
+			builder.build(component, patrol);
+
+			// A DFS termina na primeira vez em que todas as cidades da componente foram vistas.
+			std::vector<bool> seen(n, false);
+			std::size_t count = 0, last = 0;
+			while (count < components.size(component)) {
+				if (!seen[patrol[last]]) count++;
+				seen[patrol[last++]] = true;
+			}
+			CityId from = patrol[last - 1];
+
+			// Referncia: nveis a partir de `from`, cada cidade vinda da vizinha de menor posio.
+			std::vector<std::uint32_t> depth(n, UINT32_MAX);
+			std::vector<CityId> parent(n, NO_CITY), level{ from }, next;
+			depth[from] = 0;
+			for (std::uint32_t d = 1; depth[root] == UINT32_MAX; d++, std::swap(level, next)) {
+				next.clear();
+				for (CityId node : level) {
+					for (CityId target : graph.neighbors(node)) {
+						if (components.componentOf(target) != component) continue;
+						if (depth[target] == UINT32_MAX) {
+							depth[target] = d;
+							parent[target] = node;
+							next.push_back(target);
+						}
+						else if (depth[target] == d && rank(node) < rank(parent[target])) parent[target] = node;
+					}
+				}
+			}
+
+			std::vector<CityId> expected;
+			if (from != root)
+				for (CityId node = parent[root]; node != from; node = parent[node])
+					expected.insert(expected.begin(), node);
+
+			BOOST_REQUIRE((std::vector<CityId>(patrol.begin() + static_cast<std::ptrdiff_t>(last), patrol.end()) == expected));
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "Archadian.h"
+#include "City.h"
+#include "Algorithms.h"
+
+namespace {
+	std::vector<CityId> identityOrder(std::size_t size) {
+		std::vector<CityId> order(size);
+		for (std::size_t i = 0; i < size; i++)
+			order[i] = static_cast<CityId>(i);
+		return order;
+	}
+}
+
+// Teste do algoritmo de Pearce para encontrar componentes fortemente conectadas
+BOOST_AUTO_TEST_CASE(Pearce_Components) {
+	Graph graph(5, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 1, 3 }, { 3, 4 }, { 4, 3 } });
+
+	Components components = Algorithms::Pearce(graph, identityOrder(5));
+
+	BOOST_CHECK(components.count() == 2);
+
+	// Ordem topolgica: a componente {0, 1, 2} alcana a componente {3, 4}.
+	BOOST_CHECK(components.root(0) == 0);
+	BOOST_CHECK(components.size(0) == 3);
+	BOOST_CHECK(components.root(1) == 3);
+	BOOST_CHECK(components.size(1) == 2);
+
+	for (CityId node : { 0, 1, 2 })
+		BOOST_CHECK(components.componentOf(node) == 0);
+	for (CityId node : { 3, 4 })
+		BOOST_CHECK(components.componentOf(node) == 1);
+}
+
+// Teste de Pearce em um grafo com ns isolados e laos
+BOOST_AUTO_TEST_CASE(Pearce_IsolatedNodesTest) {
+	Graph graph(4, { { 1, 1 }, { 2, 3 }, { 3, 2 } });
+
+	Components components = Algorithms::Pearce(graph, identityOrder(4));
+
+	BOOST_CHECK(components.count() == 3);
+	BOOST_CHECK(components.componentOf(2) == components.componentOf(3));
+	BOOST_CHECK(components.componentOf(0) != components.componentOf(1));
+	BOOST_CHECK(components.componentOf(1) != components.componentOf(2));
+
+	for (ComponentId component = 0; component < components.count(); component++)
+		for (CityId node : components.members(component))
+			BOOST_CHECK(components.componentOf(node) == component);
+}
+
+// Teste de Pearce em um ciclo muito longo, que estouraria a pilha com uma DFS recursiva
+BOOST_AUTO_TEST_CASE(Pearce_DeepCycle) {
+	const CityId n = 1000000;
+
+	std::vector<Edge> edges;
+	for (CityId node = 0; node < n; node++)
+		edges.push_back({ node, (node + 1) % n });
+
+	Components components = Algorithms::Pearce(Graph(n, edges), identityOrder(n));
+
+	BOOST_CHECK(components.count() == 1);
+	BOOST_CHECK(components.root(0) == 0);
+	BOOST_CHECK(components.size(0) == n);
+}
+
+// Pearce e Kosaraju encontram as mesmas componentes, na mesma ordem e com as mesmas razes
+BOOST_AUTO_TEST_CASE(Pearce_MatchesKosaraju) {
+	std::mt19937 random(42);
+
+	for (int round = 0; round < 200; round++) {
+		std::size_t n = 1 + random() % 40;
+		std::size_t m = random() % (3 * n);
+
+		std::vector<Edge> edges;
+		for (std::size_t i = 0; i < m; i++)
+			edges.push_back({ static_cast<CityId>(random() % n), static_cast<CityId>(random() % n) });
+
+		Graph graph(n, edges);
+		std::vector<CityId> order = identityOrder(n);
+		std::shuffle(order.begin(), order.end(), random);
+
+		auto sccs = Algorithms::Kosaraju(graph, order);
+		Components components = Algorithms::Pearce(graph, order);
+
+		BOOST_REQUIRE(components.count() == sccs.size());
+		for (ComponentId component = 0; component < components.count(); component++) {
+			BOOST_CHECK(components.root(component) == sccs[component][0]);
+
+			auto members = components.members(component);
+			std::vector<CityId> found(members.begin(), members.end());
+			std::vector<CityId> expected = sccs[component];
+			std::sort(found.begin(), found.end());
+			std::sort(expected.begin(), expected.end());
+			BOOST_CHECK(found == expected);
+		}
+	}
+}
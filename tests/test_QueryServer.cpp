@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include <unistd.h>
+
+#include "QueryServer.h"
+
+namespace {
+	Archadian buildArchadian(std::size_t size, const std::vector<Edge>& edges) {
+		NameTable names;
+		std::vector<City> cities;
+		for (std::size_t i = 0; i < size; i++)
+			cities.push_back(City(i + 1, names.add("c" + std::to_string(i))));
+
+		return Archadian(std::move(cities), Graph(size, edges), std::move(names));
+	}
+
+	std::string ask(QueryServer& server, std::string_view query) {
+		std::string response;
+		server.answer(query, response);
+		return response;
+	}
+}
+
+// Cada consulta  respondida com uma linha
+BOOST_AUTO_TEST_CASE(QueryServer_Answers) {
+	// {0, 1, 2} -> {3, 4} -> {5}
+	Archadian archadian = buildArchadian(6, {
+		{ 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 }, { 3, 4 }, { 4, 3 }, { 4, 5 } });
+	archadian.calcCapital();
+
+	DynamicArchadian map(archadian);
+	QueryServer server(map);
+
+	BOOST_CHECK_EQUAL(ask(server, "capital"), "c2\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c0 c5"), "c0 c1 c2 c3 c4 c5\n");
+	BOOST_CHECK_EQUAL(ask(server, "  route   c4 c4 "), "c4\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c5 c0"), "-\n");
+	BOOST_CHECK_EQUAL(ask(server, "scc c4"), "2 c3 c4\n");
+	BOOST_CHECK_EQUAL(ask(server, "battalion c1"), "c2\n");
+	BOOST_CHECK_EQUAL(ask(server, "battalion c4"), "c3\n");
+
+	BOOST_CHECK_EQUAL(ask(server, "route c0 c9"), "? c9\n");
+	BOOST_CHECK_EQUAL(ask(server, "scc"), "? scc sem cidade\n");
+	BOOST_CHECK_EQUAL(ask(server, "teleport c0"), "? teleport\n");
+	BOOST_CHECK_EQUAL(ask(server, ""), "");
+
+	// As consultas enxergam as estradas abertas e fechadas pelo prprio servidor.
+	BOOST_CHECK_EQUAL(ask(server, "+ c5 c0"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "scc c5"), "6 c0 c1 c2 c3 c4 c5\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c5 c1"), "c5 c0 c1\n");
+	BOOST_CHECK_EQUAL(ask(server, "- c5 c0"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "- c5 c0"), "? sem estrada\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c5 c1"), "-\n");
+
+	// Com pesos, a rota mais curta  a de menor peso.
+	BOOST_CHECK_EQUAL(ask(server, "+ c0 c3 2"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c0 c3"), "c0 c3\n");
+	BOOST_CHECK_EQUAL(ask(server, "+ c0 c4 9"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c0 c4"), "c0 c3 c4\n");
+	BOOST_CHECK_EQUAL(ask(server, "+ c0 c4 0"), "? peso 0\n");
+
+	// Fechar uma de duas estradas paralelas fecha a mais antiga, nas duas pontas da busca.
+	BOOST_CHECK_EQUAL(ask(server, "+ c3 c4 8"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "- c3 c4"), "ok\n");
+	BOOST_CHECK_EQUAL(ask(server, "route c0 c4"), "c0 c4\n");
+
+	std::string response;
+	BOOST_CHECK(!server.answer("quit", response));
+}
+
+// As consultas chegam por um descritor, uma por linha, e as respostas saem na mesma ordem
+BOOST_AUTO_TEST_CASE(QueryServer_Serve) {
+	Archadian archadian = buildArchadian(3, { { 0, 1 }, { 1, 2 }, { 2, 0 } });
+	archadian.calcCapital();
+
+	DynamicArchadian map(archadian);
+	QueryServer server(map);
+
+	int queries[2], responses[2];
+	BOOST_REQUIRE(pipe(queries) == 0 && pipe(responses) == 0);
+
+	// A ltima consulta no tem quebra de linha; as consultas depois de quit so ignoradas.
+	std::string input = "capital\n\nroute c1 c0\r\nscc c2\nquit\ncapital";
+	BOOST_REQUIRE(write(queries[1], input.data(), input.size()) == static_cast<ssize_t>(input.size()));
+	close(queries[1]);
+
+	server.serve(queries[0], responses[1]);
+	close(queries[0]);
+	close(responses[1]);
+
+	std::string output;
+	char buffer[256];
+	for (ssize_t count; (count = read(responses[0], buffer, sizeof(buffer))) > 0;)
+		output.append(buffer, static_cast<std::size_t>(count));
+	close(responses[0]);
+
+	BOOST_CHECK_EQUAL(output, "c0\nc1 c2 c0\n3 c0 c1 c2\n");
+}
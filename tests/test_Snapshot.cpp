@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "Snapshot.h"
+
+namespace {
+	Archadian buildArchadian(std::size_t size, const std::vector<Edge>& edges) {
+		NameTable names;
+		std::vector<City> cities;
+		for (std::size_t i = 0; i < size; i++)
+			cities.push_back(City(i + 1, names.add("cidade" + std::to_string(i))));
+
+		return Archadian(std::move(cities), Graph(size, edges), std::move(names));
+	}
+
+	std::string temporaryPath(const char* name) {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+}
+
+// O arquivo mapeado devolve exatamente o mapa e os resultados escritos
+BOOST_AUTO_TEST_CASE(Snapshot_RoundTrip) {
+	// {0, 1, 2} -> {3, 4} -> {5}, com uma estrada repetida.
+	Archadian archadian = buildArchadian(6, {
+		{ 0, 1 }, { 1, 2 }, { 2, 0 }, { 2, 3 }, { 3, 4 }, { 4, 3 }, { 4, 5 }, { 4, 5 } });
+	archadian.calcCapital();
+	archadian.calcBattalionsAndPatrolling();
+
+	std::string path = temporaryPath("archadian_roundtrip.snap");
+	BOOST_REQUIRE(Snapshot::write(archadian, path.c_str()));
+
+	Snapshot snapshot(path.c_str());
+	BOOST_REQUIRE(snapshot.isValid());
+	BOOST_CHECK(snapshot.size() == 6);
+
+	const Graph& graph = archadian.getGraph();
+	Graph transposed = graph.transpose();
+	for (CityId city = 0; city < 6; city++) {
+		std::span<const CityId> out = snapshot.neighbors(city), expectedOut = graph.neighbors(city);
+		BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), expectedOut.begin(), expectedOut.end());
+
+		std::span<const CityId> in = snapshot.predecessors(city), expectedIn = transposed.neighbors(city);
+		BOOST_CHECK_EQUAL_COLLECTIONS(in.begin(), in.end(), expectedIn.begin(), expectedIn.end());
+
+		BOOST_CHECK(snapshot.getName(city) == archadian.getName(city));
+		BOOST_CHECK(snapshot.componentOf(city) == archadian.getComponents().componentOf(city));
+		BOOST_CHECK(snapshot.weights(city).empty());
+	}
+
+	BOOST_CHECK(snapshot.componentCount() == 3);
+	BOOST_CHECK(snapshot.getCapital() == archadian.getCapital());
+	BOOST_CHECK(snapshot.hasBattalions() == archadian.hasBattalions());
+
+	Battalions battalions = snapshot.getBattalions(), expected = archadian.getBattalions();
+	BOOST_CHECK_EQUAL_COLLECTIONS(battalions.begin(), battalions.end(), expected.begin(), expected.end());
+
+	BOOST_REQUIRE(snapshot.getPatrolCount() == archadian.getPatrolCount());
+	for (std::size_t patrol = 0; patrol < snapshot.getPatrolCount(); patrol++) {
+		Patrolling route = snapshot.getPatrolling(patrol), expectedRoute = archadian.getPatrolling(patrol);
+		BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), expectedRoute.begin(), expectedRoute.end());
+	}
+
+	std::filesystem::remove(path);
+}
+
+// Arquivos truncados, de outra verso ou que no so snapshots so recusados
+BOOST_AUTO_TEST_CASE(Snapshot_RejectsInvalidFiles) {
+	Archadian archadian = buildArchadian(3, { { 0, 1 }, { 1, 2 }, { 2, 0 } });
+	archadian.calcCapital();
+	archadian.calcBattalionsAndPatrolling();
+
+	std::string path = temporaryPath("archadian_invalid.snap");
+	BOOST_REQUIRE(Snapshot::write(archadian, path.c_str()));
+	std::uintmax_t size = std::filesystem::file_size(path);
+
+	BOOST_CHECK(!Snapshot(temporaryPath("archadian_missing.snap").c_str()).isValid());
+
+	// Verso diferente: o campo logo aps o identificador de 8 bytes.
+	{
+		std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(8);
+		file.put(static_cast<char>(Snapshot::VERSION + 1));
+	}
+	BOOST_CHECK(!Snapshot(path.c_str()).isValid());
+
+	BOOST_REQUIRE(Snapshot::write(archadian, path.c_str()));
+	BOOST_CHECK(Snapshot(path.c_str()).isValid());
+	std::filesystem::resize_file(path, size - 8);
+	BOOST_CHECK(!Snapshot(path.c_str()).isValid());
+
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << "6 2\nA B\nB A\n";
+	}
+	BOOST_CHECK(!Snapshot(path.c_str()).isValid());
+
+	// Sem as componentes calculadas no h o que escrever.
+	Archadian incomplete = buildArchadian(3, { { 0, 1 } });
+	BOOST_CHECK(!Snapshot::write(incomplete, path.c_str()));
+
+	std::filesystem::remove(path);
+}
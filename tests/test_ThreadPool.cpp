@@ -0,0 +1,60 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+// Todas as tarefas so executadas exatamente uma vez, por trabalhadores vlidos
+BOOST_AUTO_TEST_CASE(ThreadPool_RunsEveryTaskOnce) {
+	ThreadPool pool(4);
+	BOOST_CHECK(pool.size() == 4);
+
+	for (std::size_t count : { 0, 1, 3, 1000 }) {
+		std::vector<std::atomic<int>> runs(count);
+		std::atomic<bool> validWorker = true;
+
+		pool.run(count, [&](std::size_t task, std::size_t worker) {
+			runs[task]++;
+			if (worker >= pool.size()) validWorker = false;
+			});
+
+		BOOST_CHECK(validWorker);
+		for (std::size_t task = 0; task < count; task++)
+			BOOST_CHECK(runs[task] == 1);
+	}
+}
+
+// Um conjunto de tamanho 1 executa as tarefas em ordem, na prpria thread
+BOOST_AUTO_TEST_CASE(ThreadPool_SingleThreadIsSequential) {
+	ThreadPool pool(1);
+	BOOST_CHECK(pool.size() == 1);
+
+	std::vector<std::size_t> order;
+	pool.run(5, [&](std::size_t task, std::size_t worker) {
+		BOOST_CHECK(worker == 0);
+		order.push_back(task);
+		});
+
+	BOOST_CHECK((order == std::vector<std::size_t>{ 0, 1, 2, 3, 4 }));
+}
+
+// Tarefas de durao muito desigual: as faixas roubadas continuam cobrindo todas as tarefas
+BOOST_AUTO_TEST_CASE(ThreadPool_SkewedTasks) {
+	ThreadPool pool(3);
+
+	const std::size_t count = 500;
+	std::vector<std::atomic<int>> runs(count);
+
+	pool.run(count, [&](std::size_t task, [[maybe_unused]] std::size_t worker) {
+		// A primeira tarefa de cada faixa inicial  muito mais demorada que as outras.
+		if (task % (count / 3) == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		runs[task]++;
+		});
+
+	for (std::size_t task = 0; task < count; task++)
+		BOOST_CHECK(runs[task] == 1);
+}
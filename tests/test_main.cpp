@@ -9,6 +9,8 @@
 #include <string>
 #include <filesystem>
 #include <set>
+#include <utility>
+#include <vector>
 
 /**
  * \brief Compara duas strings de entrada para verificar igualdade em estrutura e contedo.
@@ -82,6 +84,62 @@ bool compareStrings(const std::string& input1, const std::string& input2) {
 
 }
 
+/**
+ * \brief Verifica se as patrulhas de uma sada podem ser percorridas pelas estradas da entrada.
+ *
+ * A comparao de `compareStrings` ignora a ordem das cidades de cada patrulha. Esta funo
+ * verifica a ordem: cada cidade de uma patrulha, e a primeira depois da ltima, deve ser o
+ * destino de uma estrada que sai da cidade anterior. A nica exceo  a volta da DFS: uma
+ * cidade j visitada pode aparecer sem estrada desde a anterior se a prxima cidade for
+ * descoberta a partir dela, por uma estrada.
+ *
+ * \param input O mapa de entrada: `V E` e uma estrada `A B` (ou `A B peso`) por linha.
+ * \param output A sada do programa para esse mapa.
+ *
+ * \return Verdadeiro se todas as patrulhas seguirem o sentido das estradas; falso caso contrrio.
+ */
+bool isWalkable(const std::string& input, const std::string& output) {
+	std::istringstream inputStream(input);
+	std::string line;
+	std::getline(inputStream, line);
+
+	std::set<std::pair<std::string, std::string>> roads;
+	while (std::getline(inputStream, line)) {
+		std::istringstream lineStream(line);
+		std::string source, target;
+		if (lineStream >> source >> target) roads.insert({ source, target });
+	}
+
+	std::istringstream outputStream(output);
+	std::string capital;
+	int battalions, patrols;
+	outputStream >> capital >> battalions;
+	for (int i = 0; i < battalions; ++i)
+		outputStream >> line;
+	outputStream >> patrols;
+
+	std::getline(outputStream, line);
+	for (int i = 0; i < patrols; ++i) {
+		std::getline(outputStream, line);
+		std::istringstream lineStream(line);
+		std::vector<std::string> patrol;
+		std::string city;
+		while (lineStream >> city)
+			patrol.push_back(city);
+
+		std::set<std::string> visited;
+		for (std::size_t j = 0; j < patrol.size(); ++j) {
+			visited.insert(patrol[j]);
+			const std::string& next = patrol[(j + 1) % patrol.size()];
+			bool back = j + 2 < patrol.size() && visited.contains(next) && !visited.contains(patrol[j + 2])
+				&& roads.contains({ next, patrol[j + 2] });
+			if (!roads.contains({ patrol[j], next }) && !back) return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * \brief L o contedo de um arquivo para uma string.
  *
@@ -164,5 +222,11 @@ BOOST_AUTO_TEST_CASE(IntegrationTest) {
 			"\nSada esperada:\n" + expectedOutput +
 			"\nSada gerada:\n" + actualOutput
 		);
+
+		BOOST_CHECK_MESSAGE(
+			isWalkable(input, actualOutput),
+			"Patrulha fora do sentido das estradas no arquivo: " + inputFilePath +
+			"\nSada gerada:\n" + actualOutput
+		);
 	}
 }
\ No newline at end of file